@@ -51,6 +51,15 @@
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
 
+//---- Use CRC32C (Castagnoli polynomial) for ImHashData()/ImHashStr() instead of CRC32 (Adler polynomial), in order to use SSE4.2/ARMv8 CRC instructions when the compiler targets them (e.g. -msse4.2, /arch:AVX, -march=armv8-a+crc).
+// All IDs are different from the default hash: data stored with IDs in .ini files (e.g. tables settings) will be reset once. Without those instructions, a lookup table is used (same speed as default).
+//#define IMGUI_USE_CRC32C
+
+//---- Use an open-addressing hash index in ImGuiStorage, making insertions O(1) instead of O(N) (default storage is a sorted vector: insertions move the tail of the vector).
+// Worth it for apps with many thousands of tree nodes/windows/tables. Costs ~8 bytes per pair. ImGuiStorage::Data is then kept in insertion order instead of being sorted by key.
+// Changes the layout of ImGuiStorage: this needs to be defined identically for all compilation units (including bindings).
+//#define IMGUI_USE_HASHED_STORAGE
+
 //---- Enable Test Engine / Automation features.
 //#define IMGUI_ENABLE_TEST_ENGINE                          // Enable imgui_test_engine hooks. Generally set automatically by include "imgui_te_config.h", see Test Engine for details.
 
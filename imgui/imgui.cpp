@@ -438,6 +438,9 @@ CODE
                           - likewise io.MousePos and GetMousePos() will use OS coordinates.
                             If you query mouse positions to interact with non-imgui coordinates you will need to offset them, e.g. subtract GetWindowViewport()->Pos.
 
+ - 2024/XX/XX (1.91.5) - inputtext: the edit buffer is only copied back to the user buffer on frames where text was edited (or on validation), instead of every frame while active.
+                         If you modify the user buffer while the InputText is active, your modification is not overwritten anymore on frames without edits (it is still ignored and overwritten by the next edit).
+                         Use a callback (e.g. ImGuiInputTextFlags_CallbackAlways) to modify the text of an active InputText.
  - 2024/10/18 (1.91.4) - renamed ImGuiCol_NavHighlight to ImGuiCol_NavCursor (for consistency with newly exposed and reworked features). Kept inline redirection enum (will obsolete).
  - 2024/10/14 (1.91.4) - moved ImGuiConfigFlags_NavEnableSetMousePos to standalone io.ConfigNavMoveSetMousePos bool.
                          moved ImGuiConfigFlags_NavNoCaptureKeyboard to standalone io.ConfigNavCaptureKeyboard bool (note the inverted value!).
@@ -1105,6 +1108,11 @@ CODE
 #include <TargetConditionals.h>
 #endif
 
+// [Visual Studio] Intrinsics
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>         // _InterlockedOr, _InterlockedExchange, _InterlockedCompareExchange
+#endif
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (disable: 4127)             // condition expression is constant
@@ -1181,6 +1189,9 @@ static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* wind
 
 static void             AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window);
 
+// Inputs
+static void             ImGuiIO_PopThreadSafeEvents(ImGuiIO* io, bool forward);
+
 // Settings
 static void             WindowSettingsHandler_ClearAll(ImGuiContext*, ImGuiSettingsHandler*);
 static void*            WindowSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
@@ -1458,6 +1469,7 @@ ImGuiIO::ImGuiIO()
     ConfigInputTrickleEventQueue = true;
     ConfigInputTextCursorBlink = true;
     ConfigInputTextEnterKeepActive = false;
+    ConfigInputTextUndoMemoryMax = 1024 * 1024;
     ConfigDragClickToInputText = false;
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
@@ -1569,6 +1581,7 @@ void ImGuiIO::ClearEventsQueue()
     IM_ASSERT(Ctx != NULL);
     ImGuiContext& g = *Ctx;
     g.InputEventsQueue.clear();
+    ImGuiIO_PopThreadSafeEvents(this, false);
 }
 
 // Clear current keyboard/gamepad state + current frame text input buffer. Equivalent to releasing all keys/buttons.
@@ -1872,6 +1885,161 @@ void ImGuiIO::AddFocusEvent(bool focused)
     g.InputEventsQueue.push_back(e);
 }
 
+// Atomic operations used by the thread-safe events queue.
+// On MSVC we use full-barrier Interlocked intrinsics for all three, which is stronger than needed but correct on x86/x64/ARM64.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define IM_ATOMIC_LOAD_ACQUIRE(_PTR)                (ImU32)_InterlockedOr((volatile long*)(_PTR), 0)
+#define IM_ATOMIC_STORE_RELEASE(_PTR, _VAL)         _InterlockedExchange((volatile long*)(_PTR), (long)(_VAL))
+#define IM_ATOMIC_COMPARE_EXCHANGE(_PTR, _EXP, _DES) (_InterlockedCompareExchange((volatile long*)(_PTR), (long)(_DES), (long)(_EXP)) == (long)(_EXP))
+#else
+#define IM_ATOMIC_LOAD_ACQUIRE(_PTR)                __atomic_load_n(_PTR, __ATOMIC_ACQUIRE)
+#define IM_ATOMIC_STORE_RELEASE(_PTR, _VAL)         __atomic_store_n(_PTR, _VAL, __ATOMIC_RELEASE)
+#define IM_ATOMIC_COMPARE_EXCHANGE(_PTR, _EXP, _DES) __atomic_compare_exchange_n(_PTR, &_EXP, _DES, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#endif
+
+void ImGuiIO::InitThreadSafeEventsQueue(int capacity)
+{
+    IM_ASSERT(Ctx != NULL);
+    ImGuiContext& g = *Ctx;
+    ImGuiInputEventThreadSafeQueue* queue = &g.InputEventsThreadSafeQueue;
+    if (queue->Cells != NULL)
+        IM_FREE(queue->Cells);
+    queue->Cells = NULL;
+    queue->Mask = queue->EnqueuePos = queue->DequeuePos = 0;
+    if (capacity <= 0)
+        return;
+
+    ImU32 capacity_pow2 = 2;
+    while (capacity_pow2 < (ImU32)capacity)
+        capacity_pow2 <<= 1;
+    queue->Cells = (ImGuiInputEventThreadSafeQueue::Cell*)IM_ALLOC(capacity_pow2 * sizeof(ImGuiInputEventThreadSafeQueue::Cell));
+    for (ImU32 n = 0; n < capacity_pow2; n++)
+        queue->Cells[n].Sequence = n;
+    queue->Mask = capacity_pow2 - 1;
+}
+
+// May be called from any thread
+static bool ImGuiIO_PushThreadSafeEvent(ImGuiIO* io, const ImGuiInputEvent& e)
+{
+    IM_ASSERT(io->Ctx != NULL);
+    ImGuiInputEventThreadSafeQueue* queue = &io->Ctx->InputEventsThreadSafeQueue;
+    IM_ASSERT(queue->Cells != NULL && "Need to call io.InitThreadSafeEventsQueue() first!");
+    if (queue->Cells == NULL)
+        return false;
+
+    ImU32 pos = IM_ATOMIC_LOAD_ACQUIRE(&queue->EnqueuePos);
+    for (;;)
+    {
+        ImGuiInputEventThreadSafeQueue::Cell* cell = &queue->Cells[pos & queue->Mask];
+        const int diff = (int)(IM_ATOMIC_LOAD_ACQUIRE(&cell->Sequence) - pos);
+        if (diff == 0 && IM_ATOMIC_COMPARE_EXCHANGE(&queue->EnqueuePos, pos, pos + 1))
+        {
+            cell->Event = e;
+            IM_ATOMIC_STORE_RELEASE(&cell->Sequence, pos + 1);
+            return true;
+        }
+        if (diff < 0)
+            return false; // Full
+        pos = IM_ATOMIC_LOAD_ACQUIRE(&queue->EnqueuePos);
+    }
+}
+
+// Called by NewFrame() and ClearEventsQueue() on the main thread.
+// Forward events to regular io.AddXXX() functions so they get the same filtering. We stop at 'capacity' events to not get stuck behind a fast producer.
+static void ImGuiIO_PopThreadSafeEvents(ImGuiIO* io, bool forward)
+{
+    ImGuiInputEventThreadSafeQueue* queue = &io->Ctx->InputEventsThreadSafeQueue;
+    if (queue->Cells == NULL)
+        return;
+
+    // Mouse events carry their own source: restore the sticky source set by the main thread's AddMouseSourceEvent() afterwards.
+    const ImGuiMouseSource backup_mouse_source = io->Ctx->InputEventsNextMouseSource;
+    for (ImU32 count = 0; count <= queue->Mask; count++)
+    {
+        ImGuiInputEventThreadSafeQueue::Cell* cell = &queue->Cells[queue->DequeuePos & queue->Mask];
+        if ((int)(IM_ATOMIC_LOAD_ACQUIRE(&cell->Sequence) - (queue->DequeuePos + 1)) < 0)
+            break; // Empty
+        const ImGuiInputEvent e = cell->Event;
+        IM_ATOMIC_STORE_RELEASE(&cell->Sequence, queue->DequeuePos + queue->Mask + 1);
+        queue->DequeuePos++;
+        if (!forward)
+            continue;
+
+        switch (e.Type)
+        {
+        case ImGuiInputEventType_Key:           io->AddKeyAnalogEvent(e.Key.Key, e.Key.Down, e.Key.AnalogValue); break;
+        case ImGuiInputEventType_MousePos:      io->AddMouseSourceEvent(e.MousePos.MouseSource); io->AddMousePosEvent(e.MousePos.PosX, e.MousePos.PosY); break;
+        case ImGuiInputEventType_MouseButton:   io->AddMouseSourceEvent(e.MouseButton.MouseSource); io->AddMouseButtonEvent(e.MouseButton.Button, e.MouseButton.Down); break;
+        case ImGuiInputEventType_MouseWheel:    io->AddMouseSourceEvent(e.MouseWheel.MouseSource); io->AddMouseWheelEvent(e.MouseWheel.WheelX, e.MouseWheel.WheelY); break;
+        case ImGuiInputEventType_Focus:         io->AddFocusEvent(e.AppFocused.Focused); break;
+        case ImGuiInputEventType_Text:          io->AddInputCharacter(e.Text.Char); break;
+        default: IM_ASSERT(0); break;
+        }
+    }
+    io->Ctx->InputEventsNextMouseSource = backup_mouse_source;
+}
+
+bool ImGuiIO::AddKeyEventThreadSafe(ImGuiKey key, bool down)
+{
+    return AddKeyAnalogEventThreadSafe(key, down, down ? 1.0f : 0.0f);
+}
+
+bool ImGuiIO::AddKeyAnalogEventThreadSafe(ImGuiKey key, bool down, float analog_value)
+{
+    ImGuiInputEvent e;
+    e.Type = ImGuiInputEventType_Key;
+    e.Key.Key = key;
+    e.Key.Down = down;
+    e.Key.AnalogValue = analog_value;
+    return ImGuiIO_PushThreadSafeEvent(this, e);
+}
+
+bool ImGuiIO::AddMousePosEventThreadSafe(float x, float y, ImGuiMouseSource source)
+{
+    ImGuiInputEvent e;
+    e.Type = ImGuiInputEventType_MousePos;
+    e.MousePos.PosX = x;
+    e.MousePos.PosY = y;
+    e.MousePos.MouseSource = source;
+    return ImGuiIO_PushThreadSafeEvent(this, e);
+}
+
+bool ImGuiIO::AddMouseButtonEventThreadSafe(int mouse_button, bool down, ImGuiMouseSource source)
+{
+    ImGuiInputEvent e;
+    e.Type = ImGuiInputEventType_MouseButton;
+    e.MouseButton.Button = mouse_button;
+    e.MouseButton.Down = down;
+    e.MouseButton.MouseSource = source;
+    return ImGuiIO_PushThreadSafeEvent(this, e);
+}
+
+bool ImGuiIO::AddMouseWheelEventThreadSafe(float wheel_x, float wheel_y, ImGuiMouseSource source)
+{
+    ImGuiInputEvent e;
+    e.Type = ImGuiInputEventType_MouseWheel;
+    e.MouseWheel.WheelX = wheel_x;
+    e.MouseWheel.WheelY = wheel_y;
+    e.MouseWheel.MouseSource = source;
+    return ImGuiIO_PushThreadSafeEvent(this, e);
+}
+
+bool ImGuiIO::AddFocusEventThreadSafe(bool focused)
+{
+    ImGuiInputEvent e;
+    e.Type = ImGuiInputEventType_Focus;
+    e.AppFocused.Focused = focused;
+    return ImGuiIO_PushThreadSafeEvent(this, e);
+}
+
+bool ImGuiIO::AddInputCharacterThreadSafe(unsigned int c)
+{
+    ImGuiInputEvent e;
+    e.Type = ImGuiInputEventType_Text;
+    e.Text.Char = c;
+    return ImGuiIO_PushThreadSafeEvent(this, e);
+}
+
 ImGuiPlatformIO::ImGuiPlatformIO()
 {
     // Most fields are initialized with zero
@@ -2076,26 +2244,75 @@ const char* ImStrbol(const char* buf_mid_line, const char* buf_begin) // find be
     return buf_mid_line;
 }
 
+// Case-folding info for the first and last characters of a needle, so ImStristr() can test candidates with a OR + compare.
+// Only ASCII letters are folded (same as ImToUpper()): for them we OR 0x20 into the haystack byte and compare to the lowercase letter.
+// ImGuiTextFilter stores them along with an Exclude flag, so they are compiled once by ImGuiTextFilter::Build().
+typedef ImGuiTextFilter::ImGuiTextTerm ImStristrNeedle;
+
+static void ImStristr_PrepareNeedle(ImStristrNeedle* out, const char* needle, const char* needle_end)
+{
+    out->Exclude = false;
+    out->Str = needle;
+    out->Len = (int)(needle_end - needle);
+    const char c0 = out->Len > 0 ? needle[0] : 0;
+    const char c1 = out->Len > 0 ? needle_end[-1] : 0;
+    out->FirstOr = (ImToUpper(c0) >= 'A' && ImToUpper(c0) <= 'Z') ? 0x20 : 0;
+    out->FirstVal = c0 | out->FirstOr;
+    out->LastOr = (ImToUpper(c1) >= 'A' && ImToUpper(c1) <= 'Z') ? 0x20 : 0;
+    out->LastVal = c1 | out->LastOr;
+}
+
+// Compare the middle of a candidate (first and last characters have already been matched).
+static inline bool ImStristr_MatchCandidate(const char* candidate, const ImStristrNeedle& needle)
+{
+    for (int n = 1; n < needle.Len - 1; n++)
+        if (ImToUpper(candidate[n]) != ImToUpper(needle.Str[n]))
+            return false;
+    return true;
+}
+
+static const char* ImStristr_Find(const char* haystack, const char* haystack_end, const ImStristrNeedle& needle)
+{
+    if (needle.Len == 0)
+        return haystack; // Same as strstr()
+    if (haystack_end - haystack < needle.Len)
+        return NULL;
+    const char* haystack_last = haystack_end - needle.Len; // Last valid candidate (inclusive)
+
+#ifdef IMGUI_ENABLE_SSE
+    // Test 16 candidates at a time on their first and last characters, only verify the middle of candidates passing both.
+    const __m128i first_or = _mm_set1_epi8(needle.FirstOr), first_val = _mm_set1_epi8(needle.FirstVal);
+    const __m128i last_or = _mm_set1_epi8(needle.LastOr), last_val = _mm_set1_epi8(needle.LastVal);
+    for (; haystack + 16 <= haystack_last + 1; haystack += 16)
+    {
+        const __m128i block_first = _mm_loadu_si128((const __m128i*)(const void*)haystack);
+        const __m128i block_last = _mm_loadu_si128((const __m128i*)(const void*)(haystack + needle.Len - 1));
+        const __m128i eq_first = _mm_cmpeq_epi8(_mm_or_si128(block_first, first_or), first_val);
+        const __m128i eq_last = _mm_cmpeq_epi8(_mm_or_si128(block_last, last_or), last_val);
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last));
+        for (int n = 0; mask != 0; n++, mask >>= 1)
+            if ((mask & 1) && ImStristr_MatchCandidate(haystack + n, needle))
+                return haystack + n;
+    }
+#endif
+
+    for (; haystack <= haystack_last; haystack++)
+        if ((char)(haystack[0] | needle.FirstOr) == needle.FirstVal && (char)(haystack[needle.Len - 1] | needle.LastOr) == needle.LastVal)
+            if (ImStristr_MatchCandidate(haystack, needle))
+                return haystack;
+    return NULL;
+}
+
 const char* ImStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
 {
     if (!needle_end)
         needle_end = needle + strlen(needle);
+    if (!haystack_end)
+        haystack_end = haystack + strlen(haystack);
 
-    const char un0 = (char)ImToUpper(*needle);
-    while ((!haystack_end && *haystack) || (haystack_end && haystack < haystack_end))
-    {
-        if (ImToUpper(*haystack) == un0)
-        {
-            const char* b = needle + 1;
-            for (const char* a = haystack + 1; b < needle_end; a++, b++)
-                if (ImToUpper(*a) != ImToUpper(*b))
-                    break;
-            if (b == needle_end)
-                return haystack;
-        }
-        haystack++;
-    }
-    return NULL;
+    ImStristrNeedle needle_info;
+    ImStristr_PrepareNeedle(&needle_info, needle, needle_end);
+    return ImStristr_Find(haystack, haystack_end, needle_info);
 }
 
 // Trim str by offsetting contents when there's leading data + writing a \0 at the trailing position. We use this in situation where the cost is negligible.
@@ -2222,9 +2439,47 @@ void ImFormatStringToTempBufferV(const char** out_buf, const char** out_buf_end,
     }
 }
 
+// Hardware CRC32C, processing 8 bytes per step. Output is identical to the GCrc32LookupTable[] path.
+#if defined(IMGUI_ENABLE_SSE4_2_CRC) || defined(IMGUI_ENABLE_ARM_CRC32)
+#define IMGUI_ENABLE_HW_CRC32C
+#if defined(IMGUI_ENABLE_ARM_CRC32)
+static inline ImU32 ImCrc32cU8(ImU32 crc, unsigned char v)  { return __crc32cb(crc, v); }
+static inline ImU32 ImCrc32cU64(ImU32 crc, ImU64 v)         { return __crc32cd(crc, v); }
+#elif defined(__x86_64__) || defined(_M_X64)
+static inline ImU32 ImCrc32cU8(ImU32 crc, unsigned char v)  { return _mm_crc32_u8(crc, v); }
+static inline ImU32 ImCrc32cU64(ImU32 crc, ImU64 v)         { return (ImU32)_mm_crc32_u64(crc, v); }
+#else
+static inline ImU32 ImCrc32cU8(ImU32 crc, unsigned char v)  { return _mm_crc32_u8(crc, v); }
+static inline ImU32 ImCrc32cU64(ImU32 crc, ImU64 v)         { return _mm_crc32_u32(_mm_crc32_u32(crc, (ImU32)v), (ImU32)(v >> 32)); }
+#endif
+#endif
+
 // CRC32 needs a 1KB lookup table (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
+#if defined(IMGUI_USE_CRC32C) && !defined(IMGUI_ENABLE_HW_CRC32C)
+// CRC32C (Castagnoli polynomial), same as computed by SSE4.2 _mm_crc32_xxx() and ARMv8 __crc32cx() instructions.
+static const ImU32 GCrc32LookupTable[256] =
+{
+    0x00000000,0xF26B8303,0xE13B70F7,0x1350F3F4,0xC79A971F,0x35F1141C,0x26A1E7E8,0xD4CA64EB,0x8AD958CF,0x78B2DBCC,0x6BE22838,0x9989AB3B,0x4D43CFD0,0xBF284CD3,0xAC78BF27,0x5E133C24,
+    0x105EC76F,0xE235446C,0xF165B798,0x030E349B,0xD7C45070,0x25AFD373,0x36FF2087,0xC494A384,0x9A879FA0,0x68EC1CA3,0x7BBCEF57,0x89D76C54,0x5D1D08BF,0xAF768BBC,0xBC267848,0x4E4DFB4B,
+    0x20BD8EDE,0xD2D60DDD,0xC186FE29,0x33ED7D2A,0xE72719C1,0x154C9AC2,0x061C6936,0xF477EA35,0xAA64D611,0x580F5512,0x4B5FA6E6,0xB93425E5,0x6DFE410E,0x9F95C20D,0x8CC531F9,0x7EAEB2FA,
+    0x30E349B1,0xC288CAB2,0xD1D83946,0x23B3BA45,0xF779DEAE,0x05125DAD,0x1642AE59,0xE4292D5A,0xBA3A117E,0x4851927D,0x5B016189,0xA96AE28A,0x7DA08661,0x8FCB0562,0x9C9BF696,0x6EF07595,
+    0x417B1DBC,0xB3109EBF,0xA0406D4B,0x522BEE48,0x86E18AA3,0x748A09A0,0x67DAFA54,0x95B17957,0xCBA24573,0x39C9C670,0x2A993584,0xD8F2B687,0x0C38D26C,0xFE53516F,0xED03A29B,0x1F682198,
+    0x5125DAD3,0xA34E59D0,0xB01EAA24,0x42752927,0x96BF4DCC,0x64D4CECF,0x77843D3B,0x85EFBE38,0xDBFC821C,0x2997011F,0x3AC7F2EB,0xC8AC71E8,0x1C661503,0xEE0D9600,0xFD5D65F4,0x0F36E6F7,
+    0x61C69362,0x93AD1061,0x80FDE395,0x72966096,0xA65C047D,0x5437877E,0x4767748A,0xB50CF789,0xEB1FCBAD,0x197448AE,0x0A24BB5A,0xF84F3859,0x2C855CB2,0xDEEEDFB1,0xCDBE2C45,0x3FD5AF46,
+    0x7198540D,0x83F3D70E,0x90A324FA,0x62C8A7F9,0xB602C312,0x44694011,0x5739B3E5,0xA55230E6,0xFB410CC2,0x092A8FC1,0x1A7A7C35,0xE811FF36,0x3CDB9BDD,0xCEB018DE,0xDDE0EB2A,0x2F8B6829,
+    0x82F63B78,0x709DB87B,0x63CD4B8F,0x91A6C88C,0x456CAC67,0xB7072F64,0xA457DC90,0x563C5F93,0x082F63B7,0xFA44E0B4,0xE9141340,0x1B7F9043,0xCFB5F4A8,0x3DDE77AB,0x2E8E845F,0xDCE5075C,
+    0x92A8FC17,0x60C37F14,0x73938CE0,0x81F80FE3,0x55326B08,0xA759E80B,0xB4091BFF,0x466298FC,0x1871A4D8,0xEA1A27DB,0xF94AD42F,0x0B21572C,0xDFEB33C7,0x2D80B0C4,0x3ED04330,0xCCBBC033,
+    0xA24BB5A6,0x502036A5,0x4370C551,0xB11B4652,0x65D122B9,0x97BAA1BA,0x84EA524E,0x7681D14D,0x2892ED69,0xDAF96E6A,0xC9A99D9E,0x3BC21E9D,0xEF087A76,0x1D63F975,0x0E330A81,0xFC588982,
+    0xB21572C9,0x407EF1CA,0x532E023E,0xA145813D,0x758FE5D6,0x87E466D5,0x94B49521,0x66DF1622,0x38CC2A06,0xCAA7A905,0xD9F75AF1,0x2B9CD9F2,0xFF56BD19,0x0D3D3E1A,0x1E6DCDEE,0xEC064EED,
+    0xC38D26C4,0x31E6A5C7,0x22B65633,0xD0DDD530,0x0417B1DB,0xF67C32D8,0xE52CC12C,0x1747422F,0x49547E0B,0xBB3FFD08,0xA86F0EFC,0x5A048DFF,0x8ECEE914,0x7CA56A17,0x6FF599E3,0x9D9E1AE0,
+    0xD3D3E1AB,0x21B862A8,0x32E8915C,0xC083125F,0x144976B4,0xE622F5B7,0xF5720643,0x07198540,0x590AB964,0xAB613A67,0xB831C993,0x4A5A4A90,0x9E902E7B,0x6CFBAD78,0x7FAB5E8C,0x8DC0DD8F,
+    0xE330A81A,0x115B2B19,0x020BD8ED,0xF0605BEE,0x24AA3F05,0xD6C1BC06,0xC5914FF2,0x37FACCF1,0x69E9F0D5,0x9B8273D6,0x88D28022,0x7AB90321,0xAE7367CA,0x5C18E4C9,0x4F48173D,0xBD23943E,
+    0xF36E6F75,0x0105EC76,0x12551F82,0xE03E9C81,0x34F4F86A,0xC69F7B69,0xD5CF889D,0x27A40B9E,0x79B737BA,0x8BDCB4B9,0x988C474D,0x6AE7C44E,0xBE2DA0A5,0x4C4623A6,0x5F16D052,0xAD7D5351,
+};
+#elif !defined(IMGUI_USE_CRC32C)
+// CRC32 (Adler polynomial), default.
 static const ImU32 GCrc32LookupTable[256] =
 {
     0x00000000,0x77073096,0xEE0E612C,0x990951BA,0x076DC419,0x706AF48F,0xE963A535,0x9E6495A3,0x0EDB8832,0x79DCB8A4,0xE0D5E91E,0x97D2D988,0x09B64C2B,0x7EB17CBD,0xE7B82D07,0x90BF1D91,
@@ -2244,17 +2499,28 @@ static const ImU32 GCrc32LookupTable[256] =
     0xA00AE278,0xD70DD2EE,0x4E048354,0x3903B3C2,0xA7672661,0xD06016F7,0x4969474D,0x3E6E77DB,0xAED16A4A,0xD9D65ADC,0x40DF0B66,0x37D83BF0,0xA9BCAE53,0xDEBB9EC5,0x47B2CF7F,0x30B5FFE9,
     0xBDBDF21C,0xCABAC28A,0x53B39330,0x24B4A3A6,0xBAD03605,0xCDD70693,0x54DE5729,0x23D967BF,0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
 };
+#endif
 
 // Known size hash
 // It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
 ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 {
     ImU32 crc = ~seed;
     const unsigned char* data = (const unsigned char*)data_p;
+#ifdef IMGUI_ENABLE_HW_CRC32C
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        crc = ImCrc32cU64(crc, v);
+    }
+    while (data_size-- != 0)
+        crc = ImCrc32cU8(crc, *data++);
+#else
     const ImU32* crc32_lut = GCrc32LookupTable;
     while (data_size-- != 0)
         crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
+#endif
     return ~crc;
 }
 
@@ -2263,12 +2529,39 @@ ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 // Because this syntax is rarely used we are optimizing for the common case.
 // - If we reach ### in the string we discard the hash so far and reset to the seed.
 // - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// - With hardware CRC32C, 8 bytes words which don't contain any '#' are hashed in one step.
 ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
 {
     seed = ~seed;
     ImU32 crc = seed;
     const unsigned char* data = (const unsigned char*)data_p;
+#ifdef IMGUI_ENABLE_HW_CRC32C
+    if (data_size == 0)
+        data_size = strlen(data_p);
+    const unsigned char* data_end = data + data_size;
+    while (data < data_end)
+    {
+        if (data_end - data >= 8)
+        {
+            ImU64 v;
+            memcpy(&v, data, 8);
+            const ImU64 x = v ^ 0x2323232323232323ULL; // Zero bytes where v has '#'
+            if (((x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL) == 0)
+            {
+                crc = ImCrc32cU64(crc, v);
+                data += 8;
+                continue;
+            }
+        }
+        for (const unsigned char* word_end = ImMin(data + 8, data_end); data < word_end; )
+        {
+            unsigned char c = *data++;
+            if (c == '#' && data_end - data >= 2 && data[0] == '#' && data[1] == '#')
+                crc = seed;
+            crc = ImCrc32cU8(crc, c);
+        }
+    }
+#else
     const ImU32* crc32_lut = GCrc32LookupTable;
     if (data_size != 0)
     {
@@ -2289,6 +2582,7 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
             crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
         }
     }
+#endif
     return ~crc;
 }
 
@@ -2689,26 +2983,159 @@ ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStoragePair* in_
 }
 
 IM_MSVC_RUNTIME_CHECKS_OFF
-static int IMGUI_CDECL PairComparerByID(const void* lhs, const void* rhs)
+static int PairComparerByID(const ImGuiStoragePair& lhs, const ImGuiStoragePair& rhs)
+{
+    // We can't just do a subtraction because comparers return signed integers and subtracting our ID doesn't play well with that.
+    return (lhs.key > rhs.key ? +1 : lhs.key < rhs.key ? -1 : 0);
+}
+
+static ImU32 PairGetKey(const ImGuiStoragePair& pair)
+{
+    return pair.key;
+}
+
+#ifdef IMGUI_USE_HASHED_STORAGE
+// Hashed storage: pairs are appended to Data in insertion order and never moved by insertions.
+// _Index is an open-addressing table with Robin Hood probing, storing { key, index into Data } and kept at <= 50% load.
+// Keys are generally already hashes, the multiply only protects against sequential/strided keys (e.g. indices in ImGuiSelectionBasicStorage).
+static inline ImU32 ImGuiStorage_HashSlot(ImGuiID key, ImU32 mask)
+{
+    ImU32 h = key * 0x9E3779B1u;
+    return (h ^ (h >> 16)) & mask;
+}
+
+static void ImGuiStorage_IndexInsert(ImGuiStorage* storage, ImGuiID key, int data_idx)
+{
+    ImGuiStoragePair* slots = storage->_Index.Data;
+    const ImU32 mask = (ImU32)storage->_Index.Size - 1;
+    ImGuiStoragePair entry(key, data_idx);
+    for (ImU32 pos = ImGuiStorage_HashSlot(key, mask), dist = 0; ; pos = (pos + 1) & mask, dist++)
+    {
+        ImGuiStoragePair* slot = &slots[pos];
+        if (slot->val_i == -1)
+        {
+            *slot = entry;
+            return;
+        }
+        const ImU32 slot_dist = (pos - ImGuiStorage_HashSlot(slot->key, mask)) & mask;
+        if (slot_dist < dist)
+        {
+            // Steal from the rich: the displaced entry continues probing from here.
+            ImSwap(*slot, entry);
+            dist = slot_dist;
+        }
+    }
+}
+
+static void ImGuiStorage_IndexRebuild(ImGuiStorage* storage)
 {
-    // We can't just do a subtraction because qsort uses signed integers and subtracting our ID doesn't play well with that.
-    ImGuiID lhs_v = ((const ImGuiStoragePair*)lhs)->key;
-    ImGuiID rhs_v = ((const ImGuiStoragePair*)rhs)->key;
-    return (lhs_v > rhs_v ? +1 : lhs_v < rhs_v ? -1 : 0);
+    int capacity = 16;
+    while (capacity < storage->Data.Size * 2)
+        capacity <<= 1;
+    storage->_Index.resize(0);
+    storage->_Index.resize(capacity, ImGuiStoragePair(0, -1));
+    for (int n = 0; n < storage->Data.Size; n++)
+        ImGuiStorage_IndexInsert(storage, storage->Data.Data[n].key, n);
+    storage->_IndexedCount = storage->Data.Size;
 }
 
+// Return index into Data, -1 if key is not found, -2 if the index is stale (Data was modified without going through our API).
+static int ImGuiStorage_IndexFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    if (storage->_IndexedCount != storage->Data.Size)
+        return -2;
+    if (storage->Data.Size == 0)
+        return -1;
+    const ImGuiStoragePair* slots = storage->_Index.Data;
+    const ImU32 mask = (ImU32)storage->_Index.Size - 1;
+    for (ImU32 pos = ImGuiStorage_HashSlot(key, mask), dist = 0; ; pos = (pos + 1) & mask, dist++)
+    {
+        const ImGuiStoragePair* slot = &slots[pos];
+        if (slot->val_i == -1 || ((pos - ImGuiStorage_HashSlot(slot->key, mask)) & mask) < dist)
+            return -1;
+        if (slot->key == key)
+            return (storage->Data.Data[slot->val_i].key == key) ? slot->val_i : -2; // Data may have been reordered (e.g. sorted by value)
+    }
+}
+
+// Lookups never modify the index, so const Get***() functions are safe to call concurrently.
+// A stale index is rebuilt by the next insertion or BuildSortByKey(), until then we fall back to a linear search.
+static ImGuiStoragePair* ImGuiStorage_Find(const ImGuiStorage* storage, ImGuiID key)
+{
+    const int idx = ImGuiStorage_IndexFind(storage, key);
+    if (idx >= 0)
+        return &storage->Data.Data[idx];
+    if (idx == -2)
+        for (int n = 0; n < storage->Data.Size; n++)
+            if (storage->Data.Data[n].key == key)
+                return &storage->Data.Data[n];
+    return NULL;
+}
+
+static ImGuiStoragePair* ImGuiStorage_FindOrInsert(ImGuiStorage* storage, const ImGuiStoragePair& pair)
+{
+    int idx = ImGuiStorage_IndexFind(storage, pair.key);
+    if (idx == -2)
+    {
+        ImGuiStorage_IndexRebuild(storage);
+        idx = ImGuiStorage_IndexFind(storage, pair.key);
+    }
+    if (idx >= 0)
+        return &storage->Data.Data[idx];
+    storage->Data.push_back(pair);
+    if (storage->Data.Size * 2 > storage->_Index.Size)
+    {
+        ImGuiStorage_IndexRebuild(storage);
+    }
+    else
+    {
+        ImGuiStorage_IndexInsert(storage, pair.key, storage->Data.Size - 1);
+        storage->_IndexedCount = storage->Data.Size;
+    }
+    return &storage->Data.back();
+}
+#else
+static ImGuiStoragePair* ImGuiStorage_Find(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + storage->Data.Size, key);
+    if (it == storage->Data.Data + storage->Data.Size || it->key != key)
+        return NULL;
+    return it;
+}
+
+static ImGuiStoragePair* ImGuiStorage_FindOrInsert(ImGuiStorage* storage, const ImGuiStoragePair& pair)
+{
+    ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + storage->Data.Size, pair.key);
+    if (it == storage->Data.Data + storage->Data.Size || it->key != pair.key)
+        it = storage->Data.insert(it, pair);
+    return it;
+}
+#endif
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+// With IMGUI_USE_HASHED_STORAGE, Data doesn't need to be sorted: this only rebuilds the index, in O(N).
 void ImGuiStorage::BuildSortByKey()
 {
-    ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), PairComparerByID);
+#ifdef IMGUI_USE_HASHED_STORAGE
+    ImGuiStorage_IndexRebuild(this);
+#else
+    if (Data.Size <= 256) // Radix sort has a higher fixed cost
+    {
+        ImSort<ImGuiStoragePair, PairComparerByID>(Data.Data, Data.Size);
+    }
+    else
+    {
+        ImVector<ImGuiStoragePair> temp;
+        temp.resize(Data.Size);
+        ImSortRadix<ImGuiStoragePair, PairGetKey>(Data.Data, Data.Size, temp.Data);
+    }
+#endif
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = ImGuiStorage_Find(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -2718,27 +3145,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = ImGuiStorage_Find(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = ImGuiStorage_Find(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &ImGuiStorage_FindOrInsert(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -2748,28 +3168,17 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &ImGuiStorage_FindOrInsert(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &ImGuiStorage_FindOrInsert(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
-// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_i = val;
+    ImGuiStorage_FindOrInsert(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -2779,20 +3188,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_f = val;
+    ImGuiStorage_FindOrInsert(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_p = val;
+    ImGuiStorage_FindOrInsert(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -2852,7 +3253,9 @@ void ImGuiTextFilter::Build()
     ImGuiTextRange input_range(InputBuf, InputBuf + strlen(InputBuf));
     input_range.split(',', &Filters);
 
+    // Precompile terms so PassFilter()/PassFilterBatch() don't redo it for every tested string
     CountGrep = 0;
+    Terms.resize(0);
     for (ImGuiTextRange& f : Filters)
     {
         while (f.b < f.e && ImCharIsBlankA(f.b[0]))
@@ -2861,44 +3264,82 @@ void ImGuiTextFilter::Build()
             f.e--;
         if (f.empty())
             continue;
-        if (f.b[0] != '-')
+        const bool exclude = (f.b[0] == '-');
+        if (!exclude)
             CountGrep += 1;
+        else if (f.b + 1 == f.e)
+            continue; // A lone '-' doesn't exclude anything
+        ImGuiTextTerm term;
+        ImStristr_PrepareNeedle(&term, exclude ? f.b + 1 : f.b, f.e);
+        term.Exclude = exclude;
+        Terms.push_back(term);
     }
 }
 
-bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
+static bool ImGuiTextFilter_PassTerms(const ImGuiTextFilter::ImGuiTextTerm* terms, int terms_count, int count_grep, const char* text, const char* text_end)
 {
-    if (Filters.Size == 0)
-        return true;
-
-    if (text == NULL)
-        text = text_end = "";
-
-    for (const ImGuiTextRange& f : Filters)
+    for (int n = 0; n < terms_count; n++)
     {
-        if (f.b == f.e)
-            continue;
-        if (f.b[0] == '-')
+        const ImGuiTextFilter::ImGuiTextTerm& term = terms[n];
+        if (term.Exclude)
         {
             // Subtract
-            if (ImStristr(text, text_end, f.b + 1, f.e) != NULL)
+            if (ImStristr_Find(text, text_end, term) != NULL)
                 return false;
         }
         else
         {
             // Grep
-            if (ImStristr(text, text_end, f.b, f.e) != NULL)
+            if (ImStristr_Find(text, text_end, term) != NULL)
                 return true;
         }
     }
 
     // Implicit * grep
-    if (CountGrep == 0)
+    if (count_grep == 0)
         return true;
 
     return false;
 }
 
+bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
+{
+    if (Filters.Size == 0)
+        return true;
+
+    if (text == NULL)
+        text = text_end = "";
+    else if (text_end == NULL)
+        text_end = text + strlen(text);
+
+    return ImGuiTextFilter_PassTerms(Terms.Data, Terms.Size, CountGrep, text, text_end);
+}
+
+// Test many zero-terminated strings at once.
+// Bit 'n' of 'out_bits' (same layout as ImBitArray) is set if items[n] passes, NULL items are tested as empty strings.
+int ImGuiTextFilter::PassFilterBatch(const char* const* items, int items_count, ImU32* out_bits) const
+{
+    IM_ASSERT(items_count >= 0 && (items != NULL || items_count == 0) && out_bits != NULL);
+    memset(out_bits, 0, (size_t)((items_count + 31) >> 5) * sizeof(ImU32));
+    if (Filters.Size == 0)
+    {
+        for (int n = 0; n < items_count; n++)
+            out_bits[n >> 5] |= (ImU32)1 << (n & 31);
+        return items_count;
+    }
+
+    int pass_count = 0;
+    for (int n = 0; n < items_count; n++)
+    {
+        const char* text = items[n] ? items[n] : "";
+        if (!ImGuiTextFilter_PassTerms(Terms.Data, Terms.Size, CountGrep, text, text + strlen(text)))
+            continue;
+        out_bits[n >> 5] |= (ImU32)1 << (n & 31);
+        pass_count++;
+    }
+    return pass_count;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiTextBuffer, ImGuiTextIndex
 //-----------------------------------------------------------------------------
@@ -2947,15 +3388,34 @@ void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
     va_list args_copy;
     va_copy(args_copy, args);
 
-    int len = ImFormatStringV(NULL, 0, fmt, args);         // FIXME-OPT: could do a first pass write attempt, likely successful on first pass.
+    // Attempt to write into remaining capacity first, which is typically successful. Add zero-terminator the first time.
+    // ImFormatStringV() clamps its return value, so we can't distinguish an exact fit from truncation: measure in both cases.
+    const int write_off = (Buf.Size != 0) ? Buf.Size : 1;
+    const int avail = Buf.Capacity - (write_off - 1);
+    if (avail > 1)
+    {
+        int len = ImFormatStringV(Buf.Data + write_off - 1, (size_t)avail, fmt, args);
+        if (len < avail - 1)
+        {
+            if (len > 0)
+                Buf.Size = write_off + len;
+            va_end(args_copy);
+            return;
+        }
+        if (Buf.Size > 0)
+            Buf.Data[Buf.Size - 1] = 0; // Restore zero-terminator in case we bail out below
+    }
+
+    va_list args_copy2;
+    va_copy(args_copy2, args_copy);
+    int len = ImFormatStringV(NULL, 0, fmt, args_copy);
+    va_end(args_copy);
     if (len <= 0)
     {
-        va_end(args_copy);
+        va_end(args_copy2);
         return;
     }
 
-    // Add zero-terminator the first time
-    const int write_off = (Buf.Size != 0) ? Buf.Size : 1;
     const int needed_sz = write_off + len;
     if (write_off + len >= Buf.Capacity)
     {
@@ -2964,8 +3424,8 @@ void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
     }
 
     Buf.resize(needed_sz);
-    ImFormatStringV(&Buf[write_off - 1], (size_t)len + 1, fmt, args_copy);
-    va_end(args_copy);
+    ImFormatStringV(&Buf[write_off - 1], (size_t)len + 1, fmt, args_copy2);
+    va_end(args_copy2);
 }
 
 void ImGuiTextIndex::append(const char* base, int old_size, int new_size)
@@ -2982,6 +3442,52 @@ void ImGuiTextIndex::append(const char* base, int old_size, int new_size)
     EndOffset = ImMax(EndOffset, new_size);
 }
 
+void ImGuiTextIndex::layout(const char* base, ImFont* font, float font_size, float wrap_width)
+{
+    if (LayoutFont != font || LayoutFontSize != font_size || LayoutWrapWidth != wrap_width || LayoutLinesCommitted > LineOffsets.Size)
+    {
+        clear_layout();
+        LayoutFont = font;
+        LayoutFontSize = font_size;
+        LayoutWrapWidth = wrap_width;
+    }
+
+    // Redo the last line (which may have grown since last call) and any new line.
+    // Visual lines are split the same way ImFont::RenderText() does, so rendering can start from any of them.
+    WrappedLineOffsets.resize(LayoutWrappedLinesCommitted);
+    float max_width = LayoutMaxLineWidthCommitted;
+    const float scale = font_size / font->FontSize;
+    for (int line_n = LayoutLinesCommitted; line_n < LineOffsets.Size; line_n++)
+    {
+        const char* line_begin = get_line_begin(base, line_n);
+        const char* line_end = get_line_end(base, line_n);
+        if (wrap_width > 0.0f)
+        {
+            const char* s = line_begin;
+            do
+            {
+                WrappedLineOffsets.push_back((int)(s - base));
+                float line_width;
+                s = font->CalcWordWrapLineEndA(scale, s, line_end, wrap_width, &line_width); // Single pass for wrap point and width
+                max_width = ImMax(max_width, line_width);
+                while (s < line_end && ImCharIsBlankA(*s)) // Wrapping skips upcoming blanks
+                    s++;
+            } while (s < line_end);
+        }
+        else
+        {
+            max_width = ImMax(max_width, font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, line_begin, line_end).x);
+        }
+        if (line_n + 1 < LineOffsets.Size)
+        {
+            LayoutLinesCommitted = line_n + 1;
+            LayoutWrappedLinesCommitted = WrappedLineOffsets.Size;
+            LayoutMaxLineWidthCommitted = max_width;
+        }
+    }
+    MaxLineWidth = max_width;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiListClipper
 //-----------------------------------------------------------------------------
@@ -3043,6 +3549,84 @@ static void ImGuiListClipper_SeekCursorAndSetupPrevLine(float pos_y, float line_
     }
 }
 
+// Rebuild Fenwick tree from Heights[] in O(N)
+static void ImGuiListClipperHeights_BuildTree(ImGuiListClipperHeights* heights)
+{
+    const int count = heights->Heights.Size;
+    heights->Tree.resize(count + 1);
+    heights->Tree[0] = 0.0;
+    for (int i = 1; i <= count; i++)
+        heights->Tree[i] = heights->Heights[i - 1];
+    for (int i = 1; i <= count; i++)
+        if (i + (i & -i) <= count)
+            heights->Tree[i + (i & -i)] += heights->Tree[i];
+}
+
+void ImGuiListClipperHeights::Resize(int items_count)
+{
+    IM_ASSERT(items_count >= 0);
+    if (items_count <= Heights.Size)
+    {
+        // Truncating keeps the tree valid: Tree[i] only covers items up to i
+        Heights.resize(items_count);
+        Tree.resize(items_count + 1);
+        return;
+    }
+
+    // Append new items with DefaultHeight: in O(log N) each when adding a few items (e.g. growing log), otherwise rebuild in O(N).
+    const int old_count = Heights.Size;
+    Heights.resize(items_count, DefaultHeight);
+    if (items_count - old_count > old_count || Tree.Size != old_count + 1)
+    {
+        ImGuiListClipperHeights_BuildTree(this);
+        return;
+    }
+    Tree.reserve(items_count + 1);
+    for (int i = old_count + 1; i <= items_count; i++)
+    {
+        // Tree[i] covers items (i - lowbit(i), i]
+        Tree.push_back(0.0);
+        Tree[i] = Heights[i - 1] + GetItemOffset(i - 1) - GetItemOffset(i - (i & -i));
+    }
+}
+
+void ImGuiListClipperHeights::SetItemHeight(int item_n, float height)
+{
+    IM_ASSERT(item_n >= 0 && item_n < Heights.Size && Tree.Size == Heights.Size + 1);
+    const double delta = (double)height - Heights[item_n];
+    if (delta == 0.0)
+        return;
+    Heights[item_n] = height;
+    for (int i = item_n + 1; i <= Heights.Size; i += (i & -i))
+        Tree[i] += delta;
+}
+
+double ImGuiListClipperHeights::GetItemOffset(int item_n) const
+{
+    IM_ASSERT(item_n >= 0 && item_n <= Heights.Size);
+    double offset = 0.0;
+    for (int i = item_n; i > 0; i -= (i & -i))
+        offset += Tree[i];
+    return offset;
+}
+
+int ImGuiListClipperHeights::FindItemAtOffset(double offset) const
+{
+    // Descend the tree, skipping over blocks of items ending before 'offset'
+    const int count = Heights.Size;
+    int step = 1;
+    while (step * 2 <= count)
+        step *= 2;
+    int item_n = 0;
+    for (; step > 0; step >>= 1)
+        if (item_n + step <= count && Tree[item_n + step] <= offset)
+        {
+            item_n += step;
+            offset -= Tree[item_n];
+        }
+    return item_n;
+}
+
 ImGuiListClipper::ImGuiListClipper()
 {
     memset(this, 0, sizeof(*this));
@@ -3068,6 +3652,7 @@ void ImGuiListClipper::Begin(int items_count, float items_height)
 
     StartPosY = window->DC.CursorPos.y;
     ItemsHeight = items_height;
+    ItemsHeights = NULL;
     ItemsCount = items_count;
     DisplayStart = -1;
     DisplayEnd = 0;
@@ -3082,6 +3667,20 @@ void ImGuiListClipper::Begin(int items_count, float items_height)
     StartSeekOffsetY = data->LossynessOffset;
 }
 
+// Variable heights: ItemsHeight is only used as the default height for items which haven't been measured yet.
+void ImGuiListClipper::Begin(int items_count, ImGuiListClipperHeights* items_heights)
+{
+    IM_ASSERT(items_heights != NULL);
+    IM_ASSERT(items_count >= 0 && items_count < INT_MAX && "Unknown items count is not supported with variable heights.");
+    if (Ctx == NULL)
+        Ctx = ImGui::GetCurrentContext();
+    if (items_heights->DefaultHeight <= 0.0f)
+        items_heights->DefaultHeight = Ctx->FontSize + Ctx->Style.ItemSpacing.y;
+    items_heights->Resize(items_count);
+    Begin(items_count, items_heights->DefaultHeight);
+    ItemsHeights = items_heights;
+}
+
 void ImGuiListClipper::End()
 {
     if (ImGuiListClipperData* data = (ImGuiListClipperData*)TempData)
@@ -3121,7 +3720,8 @@ void ImGuiListClipper::SeekCursorForItem(int item_n)
     // - Perform the add and multiply with double to allow seeking through larger ranges.
     // - StartPosY starts from ItemsFrozen, by adding SeekOffsetY we generally cancel that out (SeekOffsetY == LossynessOffset - ItemsFrozen * ItemsHeight).
     // - The reason we store SeekOffsetY instead of inferring it, is because we want to allow user to perform Seek after the last step, where ImGuiListClipperData is already done.
-    float pos_y = (float)((double)StartPosY + StartSeekOffsetY + (double)item_n * ItemsHeight);
+    const double item_offset_y = ItemsHeights ? ItemsHeights->GetItemOffset(item_n) : (double)item_n * ItemsHeight;
+    float pos_y = (float)((double)StartPosY + StartSeekOffsetY + item_offset_y);
     ImGuiListClipper_SeekCursorAndSetupPrevLine(pos_y, ItemsHeight);
 }
 
@@ -3136,6 +3736,13 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
     if (table && table->IsInsideRow)
         ImGui::TableEndRow(table);
 
+    // Variable heights: measure item submitted after previous step
+    if (data->MeasureItem != -1)
+    {
+        clipper->ItemsHeights->SetItemHeight(data->MeasureItem, window->DC.CursorPos.y - data->MeasureStartPosY);
+        data->MeasureItem = -1;
+    }
+
     // No items
     if (clipper->ItemsCount == 0 || GetSkipItemForListClipping())
         return false;
@@ -3147,7 +3754,14 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
         clipper->DisplayStart = data->ItemsFrozen;
         clipper->DisplayEnd = ImMin(data->ItemsFrozen + 1, clipper->ItemsCount);
         if (clipper->DisplayStart < clipper->DisplayEnd)
+        {
+            if (clipper->ItemsHeights)
+            {
+                data->MeasureItem = clipper->DisplayStart;
+                data->MeasureStartPosY = window->DC.CursorPos.y;
+            }
             data->ItemsFrozen++;
+        }
         return true;
     }
 
@@ -3190,7 +3804,10 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
     if (calc_clipping)
     {
         // Record seek offset, this is so ImGuiListClipper::Seek() can be called after ImGuiListClipperData is done
-        clipper->StartSeekOffsetY = (double)data->LossynessOffset - data->ItemsFrozen * (double)clipper->ItemsHeight;
+        if (clipper->ItemsHeights)
+            clipper->StartSeekOffsetY = (double)data->LossynessOffset - clipper->ItemsHeights->GetItemOffset(data->ItemsFrozen);
+        else
+            clipper->StartSeekOffsetY = (double)data->LossynessOffset - data->ItemsFrozen * (double)clipper->ItemsHeight;
 
         if (g.LogEnabled)
         {
@@ -3239,11 +3856,22 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
         // - Very important: when a starting position is after our maximum item, we set Min to (ItemsCount - 1). This allows us to handle most forms of wrapping.
         // - Due to how Selectable extra padding they tend to be "unaligned" with exact unit in the item list,
         //   which with the flooring/ceiling tend to lead to 2 items instead of one being submitted.
+        // - With variable heights, we locate items from their offset relative to the current cursor position (which is where item 'already_submitted' starts).
+        const double heights_base_offset = clipper->ItemsHeights ? clipper->ItemsHeights->GetItemOffset(already_submitted) - window->DC.CursorPos.y - data->LossynessOffset : 0.0;
         for (ImGuiListClipperRange& range : data->Ranges)
             if (range.PosToIndexConvert)
             {
-                int m1 = (int)(((double)range.Min - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight);
-                int m2 = (int)((((double)range.Max - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight) + 0.999999f);
+                int m1, m2;
+                if (ImGuiListClipperHeights* heights = clipper->ItemsHeights)
+                {
+                    m1 = heights->FindItemAtOffset((double)range.Min + heights_base_offset) - already_submitted;
+                    m2 = heights->FindItemAtOffset((double)range.Max + heights_base_offset) + 1 - already_submitted;
+                }
+                else
+                {
+                    m1 = (int)(((double)range.Min - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight);
+                    m2 = (int)((((double)range.Max - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight) + 0.999999f);
+                }
                 range.Min = ImClamp(already_submitted + m1 + range.PosToIndexOffsetMin, already_submitted, clipper->ItemsCount - 1);
                 range.Max = ImClamp(already_submitted + m2 + range.PosToIndexOffsetMax, range.Min + 1, clipper->ItemsCount);
                 range.PosToIndexConvert = false;
@@ -3258,6 +3886,15 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
         clipper->DisplayEnd = ImMin(data->Ranges[data->StepNo].Max, clipper->ItemsCount);
         if (clipper->DisplayStart > already_submitted) //-V1051
             clipper->SeekCursorForItem(clipper->DisplayStart);
+        if (clipper->ItemsHeights && clipper->DisplayStart < clipper->DisplayEnd)
+        {
+            // Variable heights: display one item at a time so we can measure it on the next step (remaining items are moved to a new range)
+            if (clipper->DisplayStart + 1 < clipper->DisplayEnd)
+                data->Ranges.insert(data->Ranges.Data + data->StepNo + 1, ImGuiListClipperRange::FromIndices(clipper->DisplayStart + 1, clipper->DisplayEnd));
+            clipper->DisplayEnd = clipper->DisplayStart + 1;
+            data->MeasureItem = clipper->DisplayStart;
+            data->MeasureStartPosY = window->DC.CursorPos.y;
+        }
         data->StepNo++;
         if (clipper->DisplayStart == clipper->DisplayEnd && data->StepNo < data->Ranges.Size)
             continue;
@@ -4146,6 +4783,7 @@ void ImGui::Initialize()
         ini_handler.ReadLineFn = WindowSettingsHandler_ReadLine;
         ini_handler.ApplyAllFn = WindowSettingsHandler_ApplyAll;
         ini_handler.WriteAllFn = WindowSettingsHandler_WriteAll;
+        ini_handler.WriteCacheAllowed = true;
         AddSettingsHandler(&ini_handler);
     }
     TableSettingsAddSettingsHandler();
@@ -4201,14 +4839,20 @@ void ImGui::Shutdown()
     }
     g.IO.Fonts = NULL;
     g.DrawListSharedData.TempBuffer.clear();
+    g.FrameArena.Clear();
 
     // Cleanup of other data are conditional on actually having initialized Dear ImGui.
     if (!g.Initialized)
         return;
 
     // Save settings (unless we haven't attempted to load them: CreateContext/DestroyContext without a call to NewFrame shouldn't save an empty file)
+    // Write all handlers again for this last save, in case some changes haven't been signaled with MarkIniSettingsDirty().
     if (g.SettingsLoaded && g.IO.IniFilename != NULL)
+    {
+        for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+            handler.WriteCacheValid = false;
         SaveIniSettingsToDisk(g.IO.IniFilename);
+    }
 
     // Destroy platform windows
     DestroyPlatformWindows();
@@ -4245,6 +4889,7 @@ void ImGui::Shutdown()
     g.TabBars.Clear();
     g.CurrentTabBarStack.clear();
     g.ShrinkWidthBuffer.clear();
+    g.ComboItemsScratch.Offsets.clear();
 
     g.ClipperTempData.clear_destruct();
 
@@ -4262,6 +4907,8 @@ void ImGui::Shutdown()
 
     g.SettingsWindows.clear();
     g.SettingsHandlers.clear();
+    g.SettingsIniDataPrev.clear();
+    g.IO.InitThreadSafeEventsQueue(0);
 
     if (g.LogFile)
     {
@@ -4831,6 +5478,89 @@ void ImGui::DebugAllocHook(ImGuiDebugAllocInfo* info, int frame_count, void* ptr
     }
 }
 
+void* ImLinearAllocator::Alloc(size_t size, size_t align)
+{
+    IM_ASSERT(align > 0 && (align & (align - 1)) == 0 && align <= 16); // Overflow allocations rely on MemAlloc() alignment
+    if (size < IM_LINEAR_ALLOCATOR_LARGE_ALLOC)
+    {
+        const size_t offset = IM_MEMALIGN(BlockUsed, align);
+        TotalUsed += IM_MEMALIGN(size, align);
+        if (Block != NULL && offset + size <= BlockSize)
+        {
+            BlockUsed = offset + size;
+            return Block + offset;
+        }
+    }
+    void* ptr = IM_ALLOC(size);
+    Overflow.push_back(ptr);
+    return ptr;
+}
+
+// Fit peak usage, with some slack
+static size_t ImLinearAllocator_CalcBlockSize(size_t peak_used)
+{
+    return IM_MEMALIGN(ImMax(peak_used + peak_used / 2, (size_t)4096), (size_t)4096);
+}
+
+static void ImLinearAllocator_ResizeBlock(ImLinearAllocator* arena, size_t block_size)
+{
+    if (arena->Block != NULL)
+        IM_FREE(arena->Block);
+    arena->BlockSize = block_size;
+    arena->Block = (char*)IM_ALLOC(block_size);
+    arena->UnderusedPeak = 0;
+    arena->UnderusedFrames = 0;
+}
+
+void ImLinearAllocator::Reset()
+{
+    for (void* ptr : Overflow)
+        IM_FREE(ptr);
+    Overflow.resize(0);
+    if (TotalUsed > BlockSize)
+    {
+        ImLinearAllocator_ResizeBlock(this, ImLinearAllocator_CalcBlockSize(TotalUsed));
+    }
+    else if (TotalUsed < BlockSize / 4)
+    {
+        // Shrink block after a spike in usage, once usage has stayed low for a while
+        UnderusedPeak = ImMax(UnderusedPeak, TotalUsed);
+        if (++UnderusedFrames >= IM_LINEAR_ALLOCATOR_SHRINK_FRAMES)
+        {
+            const size_t block_size = ImLinearAllocator_CalcBlockSize(UnderusedPeak);
+            if (block_size < BlockSize)
+                ImLinearAllocator_ResizeBlock(this, block_size);
+            UnderusedPeak = 0;
+            UnderusedFrames = 0;
+        }
+    }
+    else
+    {
+        UnderusedPeak = 0;
+        UnderusedFrames = 0;
+    }
+    BlockUsed = TotalUsed = 0;
+}
+
+void ImLinearAllocator::Clear()
+{
+    Reset();
+    if (Block != NULL)
+        IM_FREE(Block);
+    Block = NULL;
+    BlockSize = 0;
+    UnderusedPeak = 0;
+    UnderusedFrames = 0;
+    Overflow.clear();
+}
+
+// Transient memory, valid until next call to NewFrame(). Don't free it.
+void* ImGui::MemAllocFrame(size_t size, size_t align)
+{
+    ImGuiContext& g = *GImGui;
+    return g.FrameArena.Alloc(size, align);
+}
+
 const char* ImGui::GetClipboardText()
 {
     ImGuiContext& g = *GImGui;
@@ -5224,9 +5954,10 @@ static void SetupDrawListSharedData()
     g.DrawListSharedData.CurveTessellationTol = g.Style.CurveTessellationTol;
     g.DrawListSharedData.SetCircleTessellationMaxError(g.Style.CircleTessellationMaxError);
     g.DrawListSharedData.InitialFlags = ImDrawListFlags_None;
+    g.DrawListSharedData.WrapLayoutCache.clear();
     if (g.Style.AntiAliasedLines)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLines;
-    if (g.Style.AntiAliasedLinesUseTex && !(g.IO.Fonts->Flags & ImFontAtlasFlags_NoBakedLines))
+    if (g.Style.AntiAliasedLinesUseTex && !(g.IO.Fonts->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField)))
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLinesUseTex;
     if (g.Style.AntiAliasedFill)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
@@ -5261,6 +5992,10 @@ void ImGui::NewFrame()
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
+    if (g.GcCompactAll)
+        g.FrameArena.Clear();
+    else
+        g.FrameArena.Reset();
 
     // Calculate frame-rate for the user, as a purely luxurious feature
     g.FramerateSecPerFrameAccum += g.IO.DeltaTime - g.FramerateSecPerFrame[g.FramerateSecPerFrameIdx];
@@ -5271,6 +6006,7 @@ void ImGui::NewFrame()
 
     // Process input queue (trickle as many events as possible), turn events into writes to IO structure
     g.InputEventsTrail.resize(0);
+    ImGuiIO_PopThreadSafeEvents(&g.IO, true);
     UpdateInputEvents(g.IO.ConfigInputTrickleEventQueue);
 
     // Update viewports (after processing input queue, so io.MouseHoveredViewport is set)
@@ -5513,10 +6249,8 @@ void ImGui::NewFrame()
 }
 
 // FIXME: Add a more explicit sort order in the window structure.
-static int IMGUI_CDECL ChildWindowComparer(const void* lhs, const void* rhs)
+static int ChildWindowComparer(ImGuiWindow* const& a, ImGuiWindow* const& b)
 {
-    const ImGuiWindow* const a = *(const ImGuiWindow* const *)lhs;
-    const ImGuiWindow* const b = *(const ImGuiWindow* const *)rhs;
     if (int d = (a->Flags & ImGuiWindowFlags_Popup) - (b->Flags & ImGuiWindowFlags_Popup))
         return d;
     if (int d = (a->Flags & ImGuiWindowFlags_Tooltip) - (b->Flags & ImGuiWindowFlags_Tooltip))
@@ -5529,8 +6263,15 @@ static void AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, Im
     out_sorted_windows->push_back(window);
     if (window->Active)
     {
+        // ChildWindows[] is appended in Begin() order so it is typically already sorted, unless a child popup/tooltip got in the middle.
+        // Checking is O(N) and avoids an O(N log N) sort every frame for windows with thousands of children.
         int count = window->DC.ChildWindows.Size;
-        ImQsort(window->DC.ChildWindows.Data, (size_t)count, sizeof(ImGuiWindow*), ChildWindowComparer);
+        for (int i = 1; i < count; i++)
+            if (ChildWindowComparer(window->DC.ChildWindows.Data[i - 1], window->DC.ChildWindows.Data[i]) > 0)
+            {
+                ImSort<ImGuiWindow*, ChildWindowComparer>(window->DC.ChildWindows.Data, count);
+                break;
+            }
         for (int i = 0; i < count; i++)
         {
             ImGuiWindow* child = window->DC.ChildWindows[i];
@@ -5938,12 +6679,18 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
         text_display_end = FindRenderedTextEnd(text, text_end);      // Hide anything after a '##' string
     else
         text_display_end = text_end;
+    if (text_display_end == NULL && wrap_width > 0.0f)
+        text_display_end = text + strlen(text); // Wrap layout cache needs an explicit end
 
     ImFont* font = g.Font;
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+    ImVec2 text_size;
+    if (wrap_width > 0.0f)
+        text_size = ImFontUpdateWrapLayout(&g.DrawListSharedData.WrapLayoutCache, font, font_size, wrap_width, text, text_display_end)->Size; // Layout is reused by RenderText() on same text
+    else
+        text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
     // FIXME: This has been here since Dec 2015 (7b0bf230) but down the line we want this out.
@@ -15218,19 +15965,30 @@ void ImGui::UpdateSettings()
     }
 }
 
+// Unknown origin: all handlers will be written again
 void ImGui::MarkIniSettingsDirty()
 {
     ImGuiContext& g = *GImGui;
     if (g.SettingsDirtyTimer <= 0.0f)
         g.SettingsDirtyTimer = g.IO.IniSavingRate;
+    for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+        handler.WriteCacheValid = false;
 }
 
 void ImGui::MarkIniSettingsDirty(ImGuiWindow* window)
 {
-    ImGuiContext& g = *GImGui;
     if (!(window->Flags & ImGuiWindowFlags_NoSavedSettings))
-        if (g.SettingsDirtyTimer <= 0.0f)
-            g.SettingsDirtyTimer = g.IO.IniSavingRate;
+        if (ImGuiSettingsHandler* handler = FindSettingsHandler("Window"))
+            MarkIniSettingsDirty(handler);
+}
+
+// Only 'handler' will be written again, other handlers with WriteCacheAllowed may reuse their previous output
+void ImGui::MarkIniSettingsDirty(ImGuiSettingsHandler* handler)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.SettingsDirtyTimer <= 0.0f)
+        g.SettingsDirtyTimer = g.IO.IniSavingRate;
+    handler->WriteCacheValid = false;
 }
 
 void ImGui::AddSettingsHandler(const ImGuiSettingsHandler* handler)
@@ -15262,9 +16020,13 @@ void ImGui::ClearIniSettings()
 {
     ImGuiContext& g = *GImGui;
     g.SettingsIniData.clear();
+    g.SettingsIniDataPrev.clear();
     for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+    {
         if (handler.ClearAllFn != NULL)
             handler.ClearAllFn(&g, &handler);
+        handler.WriteCacheValid = false;
+    }
 }
 
 void ImGui::LoadIniSettingsFromDisk(const char* ini_filename)
@@ -15300,8 +16062,11 @@ void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
     // Call pre-read handlers
     // Some types will clear their data (e.g. dock information) some types will allow merge/override (window)
     for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+    {
         if (handler.ReadInitFn != NULL)
             handler.ReadInitFn(&g, &handler);
+        handler.WriteCacheValid = false;
+    }
 
     void* entry_data = NULL;
     ImGuiSettingsHandler* entry_handler = NULL;
@@ -15367,14 +16132,26 @@ void ImGui::SaveIniSettingsToDisk(const char* ini_filename)
 }
 
 // Call registered handlers (e.g. SettingsHandlerWindow_WriteAll() + custom handlers) to write their stuff into a text buffer
+// Handlers with WriteCacheAllowed which haven't been marked dirty since the last call reuse their previous output,
+// so e.g. moving a window doesn't require formatting hundreds of table settings again.
 const char* ImGui::SaveIniSettingsToMemory(size_t* out_size)
 {
     ImGuiContext& g = *GImGui;
     g.SettingsDirtyTimer = 0.0f;
+    g.SettingsIniData.Buf.swap(g.SettingsIniDataPrev.Buf);
     g.SettingsIniData.Buf.resize(0);
     g.SettingsIniData.Buf.push_back(0);
     for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
-        handler.WriteAllFn(&g, &handler, &g.SettingsIniData);
+    {
+        const int write_offset = g.SettingsIniData.size();
+        if (handler.WriteCacheAllowed && handler.WriteCacheValid)
+            g.SettingsIniData.append(g.SettingsIniDataPrev.begin() + handler.WriteCacheOffset, g.SettingsIniDataPrev.begin() + handler.WriteCacheOffset + handler.WriteCacheSize);
+        else
+            handler.WriteAllFn(&g, &handler, &g.SettingsIniData);
+        handler.WriteCacheOffset = write_offset;
+        handler.WriteCacheSize = g.SettingsIniData.size() - write_offset;
+        handler.WriteCacheValid = handler.WriteCacheAllowed;
+    }
     if (out_size)
         *out_size = (size_t)g.SettingsIniData.size();
     return g.SettingsIniData.c_str();
@@ -15438,6 +16215,8 @@ void ImGui::ClearWindowSettings(const char* name)
     }
     if (ImGuiWindowSettings* settings = window ? FindWindowSettingsByWindow(window) : FindWindowSettingsByID(ImHashStr(name)))
         settings->WantDelete = true;
+    if (ImGuiSettingsHandler* handler = FindSettingsHandler("Window"))
+        handler->WriteCacheValid = false;
 }
 
 static void WindowSettingsHandler_ClearAll(ImGuiContext* ctx, ImGuiSettingsHandler*)
@@ -17011,10 +17790,8 @@ static void ImGui::DockContextRemoveNode(ImGuiContext* ctx, ImGuiDockNode* node,
     }
 }
 
-static int IMGUI_CDECL DockNodeComparerDepthMostFirst(const void* lhs, const void* rhs)
+static int DockNodeComparerDepthMostFirst(ImGuiDockNode* const& a, ImGuiDockNode* const& b)
 {
-    const ImGuiDockNode* a = *(const ImGuiDockNode* const*)lhs;
-    const ImGuiDockNode* b = *(const ImGuiDockNode* const*)rhs;
     return ImGui::DockNodeGetDepth(b) - ImGui::DockNodeGetDepth(a);
 }
 
@@ -18229,10 +19006,10 @@ static void ImGui::DockNodeUpdate(ImGuiDockNode* node)
 }
 
 // Compare TabItem nodes given the last known DockOrder (will persist in .ini file as hint), used to sort tabs when multiple tabs are added on the same frame.
-static int IMGUI_CDECL TabItemComparerByDockOrder(const void* lhs, const void* rhs)
+static int TabItemComparerByDockOrder(const ImGuiTabItem& lhs, const ImGuiTabItem& rhs)
 {
-    ImGuiWindow* a = ((const ImGuiTabItem*)lhs)->Window;
-    ImGuiWindow* b = ((const ImGuiTabItem*)rhs)->Window;
+    ImGuiWindow* a = lhs.Window;
+    ImGuiWindow* b = rhs.Window;
     if (int d = ((a->DockOrder == -1) ? INT_MAX : a->DockOrder) - ((b->DockOrder == -1) ? INT_MAX : b->DockOrder))
         return d;
     return (a->BeginOrderWithinContext - b->BeginOrderWithinContext);
@@ -18454,7 +19231,7 @@ static void ImGui::DockNodeUpdateTabBar(ImGuiDockNode* node, ImGuiWindow* host_w
         }
         IMGUI_DEBUG_LOG_DOCKING("[docking] SelectedTabId = 0x%08X, NavWindow->TabId = 0x%08X\n", node->SelectedTabId, g.NavWindow ? g.NavWindow->TabId : -1);
         if (tab_bar->Tabs.Size > tabs_unsorted_start + 1)
-            ImQsort(tab_bar->Tabs.Data + tabs_unsorted_start, tab_bar->Tabs.Size - tabs_unsorted_start, sizeof(ImGuiTabItem), TabItemComparerByDockOrder);
+            ImSort<ImGuiTabItem, TabItemComparerByDockOrder>(tab_bar->Tabs.Data + tabs_unsorted_start, tab_bar->Tabs.Size - tabs_unsorted_start);
     }
 
     // Apply NavWindow focus back to the tab bar
@@ -19746,7 +20523,7 @@ void ImGui::DockBuilderRemoveNodeChildNodes(ImGuiID root_id)
 
     // Not really efficient, but easier to destroy a whole hierarchy considering DockContextRemoveNode is attempting to merge nodes
     if (nodes_to_remove.Size > 1)
-        ImQsort(nodes_to_remove.Data, nodes_to_remove.Size, sizeof(ImGuiDockNode*), DockNodeComparerDepthMostFirst);
+        ImSort<ImGuiDockNode*, DockNodeComparerDepthMostFirst>(nodes_to_remove.Data, nodes_to_remove.Size);
     for (int n = 0; n < nodes_to_remove.Size; n++)
         DockContextRemoveNode(&g, nodes_to_remove[n], false);
 
@@ -20847,13 +21624,16 @@ static void RenderViewportsThumbnails()
     ImGui::Dummy(bb_full.GetSize() * SCALE);
 }
 
-static int IMGUI_CDECL ViewportComparerByLastFocusedStampCount(const void* lhs, const void* rhs)
+static int ViewportComparerByLastFocusedStampCount(ImGuiViewportP* const& a, ImGuiViewportP* const& b)
 {
-    const ImGuiViewportP* a = *(const ImGuiViewportP* const*)lhs;
-    const ImGuiViewportP* b = *(const ImGuiViewportP* const*)rhs;
     return b->LastFocusedStampCount - a->LastFocusedStampCount;
 }
 
+static int WindowComparerByBeginOrder(ImGuiWindow* const& a, ImGuiWindow* const& b)
+{
+    return a->BeginOrderWithinContext - b->BeginOrderWithinContext;
+}
+
 // Draw an arbitrary US keyboard layout to visualize translated keys
 void ImGui::DebugRenderKeyboardPreview(ImDrawList* draw_list)
 {
@@ -20998,6 +21778,8 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
         Checkbox("Tint with Text Color", &cfg->ShowAtlasTintedWithTextColor); // Using text color ensure visibility of core atlas data, but will alter custom colored icons
         ImVec4 tint_col = cfg->ShowAtlasTintedWithTextColor ? GetStyleColorVec4(ImGuiCol_Text) : ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
         ImVec4 border_col = GetStyleColorVec4(ImGuiCol_Border);
+        const int tex_surface = atlas->TexWidth * atlas->TexHeight;
+        Text("Packing efficiency: %.1f%% (%d/%d pixels)", tex_surface > 0 ? 100.0f * atlas->TexPackedSurface / tex_surface : 0.0f, atlas->TexPackedSurface, tex_surface);
         Image(atlas->TexID, ImVec2((float)atlas->TexWidth, (float)atlas->TexHeight), ImVec2(0.0f, 0.0f), ImVec2(1.0f, 1.0f), tint_col, border_col);
         TreePop();
     }
@@ -21203,8 +21985,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
             for (ImGuiWindow* window : g.Windows)
                 if (window->LastFrameActive + 1 >= g.FrameCount)
                     temp_buffer.push_back(window);
-            struct Func { static int IMGUI_CDECL WindowComparerByBeginOrder(const void* lhs, const void* rhs) { return ((int)(*(const ImGuiWindow* const *)lhs)->BeginOrderWithinContext - (*(const ImGuiWindow* const*)rhs)->BeginOrderWithinContext); } };
-            ImQsort(temp_buffer.Data, (size_t)temp_buffer.Size, sizeof(ImGuiWindow*), Func::WindowComparerByBeginOrder);
+            ImSort<ImGuiWindow*, WindowComparerByBeginOrder>(temp_buffer.Data, temp_buffer.Size);
             DebugNodeWindowsListByBeginStackParent(temp_buffer.Data, temp_buffer.Size, NULL);
             TreePop();
         }
@@ -21268,7 +22049,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
             viewports.resize(g.Viewports.Size);
             memcpy(viewports.Data, g.Viewports.Data, g.Viewports.size_in_bytes());
             if (viewports.Size > 1)
-                ImQsort(viewports.Data, viewports.Size, sizeof(ImGuiViewport*), ViewportComparerByLastFocusedStampCount);
+                ImSort<ImGuiViewportP*, ViewportComparerByLastFocusedStampCount>(viewports.Data, viewports.Size);
             for (ImGuiViewportP* viewport : viewports)
             {
                 BulletText("Viewport #%d, ID: 0x%08X, LastFocused = %08d, PlatformFocused = %s, Window: \"%s\"",
@@ -21395,7 +22176,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         if (TreeNode("SettingsHandlers", "Settings handlers: (%d)", g.SettingsHandlers.Size))
         {
             for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
-                BulletText("\"%s\"", handler.TypeName);
+                BulletText("\"%s\"%s", handler.TypeName, (handler.WriteCacheAllowed && handler.WriteCacheValid) ? " (cached)" : "");
             TreePop();
         }
         if (TreeNode("SettingsWindows", "Settings packed data: Windows: %d bytes", g.SettingsWindows.size()))
@@ -21451,6 +22232,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     {
         ImGuiDebugAllocInfo* info = &g.DebugAllocInfo;
         Text("%d current allocations", info->TotalAllocCount - info->TotalFreeCount);
+        Text("Frame arena: %d/%d bytes used, %d overflow allocations", (int)g.FrameArena.TotalUsed, (int)g.FrameArena.BlockSize, g.FrameArena.Overflow.Size);
         if (SmallButton("GC now")) { g.GcCompactAll = true; }
         Text("Recent frames with allocations:");
         int buf_size = IM_ARRAYSIZE(info->LastEntriesBuf);
@@ -47,7 +47,7 @@ Index of this file:
 // [SECTION] ImGuiIO
 // [SECTION] Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiWindowClass, ImGuiPayload)
 // [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, Math Operators, ImColor)
-// [SECTION] Multi-Select API flags and structures (ImGuiMultiSelectFlags, ImGuiMultiSelectIO, ImGuiSelectionRequest, ImGuiSelectionBasicStorage, ImGuiSelectionExternalStorage)
+// [SECTION] Multi-Select API flags and structures (ImGuiMultiSelectFlags, ImGuiMultiSelectIO, ImGuiSelectionRequest, ImGuiSelectionBasicStorage, ImGuiSelectionExternalStorage, ImGuiSelectionRangeStorage)
 // [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
 // [SECTION] Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFont)
 // [SECTION] Viewports (ImGuiViewportFlags, ImGuiViewport)
@@ -178,6 +178,7 @@ struct ImGuiIO;                     // Main configuration and I/O between your a
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiKeyData;                // Storage for ImGuiIO and IsKeyDown(), IsKeyPressed() etc functions.
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiListClipperHeights;     // Helper storing measured item heights for ImGuiListClipper, for items of variable height
 struct ImGuiMultiSelectIO;          // Structure to interact with a BeginMultiSelect()/EndMultiSelect() block
 struct ImGuiOnceUponAFrame;         // Helper for running a block of code not more than once a frame
 struct ImGuiPayload;                // User data payload for drag and drop operations
@@ -186,6 +187,7 @@ struct ImGuiPlatformImeData;        // Platform IME data for io.PlatformSetImeDa
 struct ImGuiPlatformMonitor;        // Multi-viewport support: user-provided bounds for each connected monitor/display. Used when positioning popups and tooltips to avoid them straddling monitors
 struct ImGuiSelectionBasicStorage;  // Optional helper to store multi-selection state + apply multi-selection requests.
 struct ImGuiSelectionExternalStorage;//Optional helper to apply multi-selection requests to existing randomly accessible storage.
+struct ImGuiSelectionRangeStorage;  // Optional helper to store multi-selection state as sorted ranges of indices + apply multi-selection requests.
 struct ImGuiSelectionRequest;       // A selection request (stored in ImGuiMultiSelectIO)
 struct ImGuiSizeCallbackData;       // Callback data when using SetNextWindowSizeConstraints() (rare/advanced use)
 struct ImGuiStorage;                // Helper for key->value storage (container sorted by key)
@@ -193,8 +195,12 @@ struct ImGuiStoragePair;            // Helper for key->value storage (pair)
 struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTableSortSpecs;         // Sorting specifications for a table (often handling sort specs for a single column, occasionally more)
 struct ImGuiTableColumnSortSpecs;   // Sorting specification for one column of a table
+struct ImGuiTableSortKey;           // Sorting key of one item for one column, for TableSortItems()
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbbb][,ccccc]")
+struct ImGuiTextIndex;              // Helper to maintain a line index for a large text buffer, to display it with TextUnformatted() in O(visible lines)
+struct ImGuiTreeClipper;            // Helper to submit a large tree hierarchy with TreeNode(), only submitting visible rows
+struct ImGuiTreeClipperRow;         // A visible node of ImGuiTreeClipper
 struct ImGuiViewport;               // A Platform Window (always 1 unless multi-viewport are enabled. One per platform window to output to). In the future may represent Platform Monitor
 struct ImGuiWindowClass;            // Window class (rare/advanced uses: provide hints to the platform backend via altered viewport flags and parent/child info)
 
@@ -285,6 +291,7 @@ typedef ImS64 ImGuiSelectionUserData;
 // Callback and functions types
 typedef int     (*ImGuiInputTextCallback)(ImGuiInputTextCallbackData* data);    // Callback function for ImGui::InputText()
 typedef void    (*ImGuiSizeCallback)(ImGuiSizeCallbackData* data);              // Callback function for ImGui::SetNextWindowSizeConstraints()
+typedef void    (*ImGuiTableSortKeyGetter)(void* user_data, int item_idx, const ImGuiTableColumnSortSpecs* spec, ImGuiTableSortKey* out_key); // Function signature for ImGui::TableSortItems()
 typedef void*   (*ImGuiMemAllocFunc)(size_t sz, void* user_data);               // Function signature for ImGui::SetAllocatorFunctions()
 typedef void    (*ImGuiMemFreeFunc)(void* ptr, void* user_data);                // Function signature for ImGui::SetAllocatorFunctions()
 
@@ -536,6 +543,7 @@ namespace ImGui
 
     // Widgets: Text
     IMGUI_API void          TextUnformatted(const char* text, const char* text_end = NULL); // raw text without formatting. Roughly equivalent to Text("%s", text) but: A) doesn't require null terminated string if 'text_end' is specified, B) it's faster, no memory copy is done, no buffer size limits, recommended for long chunks of text.
+    IMGUI_API void          TextUnformatted(const char* text, const char* text_end, ImGuiTextIndex* line_index); // raw text using a persistent line index: only visible lines are processed, including when word-wrapping. For large append-only text (e.g. logs), see ImGuiTextIndex.
     IMGUI_API void          Text(const char* fmt, ...)                                      IM_FMTARGS(1); // formatted text
     IMGUI_API void          TextV(const char* fmt, va_list args)                            IM_FMTLIST(1);
     IMGUI_API void          TextColored(const ImVec4& col, const char* fmt, ...)            IM_FMTARGS(2); // shortcut for PushStyleColor(ImGuiCol_Text, col); Text(fmt, ...); PopStyleColor();
@@ -814,12 +822,15 @@ namespace ImGui
     //        - TableNextRow() -> TableNextColumn()      -> Text("Hello 0") -> TableNextColumn()      -> Text("Hello 1")  // OK
     //        -                   TableNextColumn()      -> Text("Hello 0") -> TableNextColumn()      -> Text("Hello 1")  // OK: TableNextColumn() automatically gets to next row!
     //        - TableNextRow()                           -> Text("Hello 0")                                               // Not OK! Missing TableSetColumnIndex() or TableNextColumn()! Text will not appear!
+    //    - For tables with many columns and horizontal scrolling, use TableNextRow() + 'while (TableNextVisibleColumn()) { ... }' to only
+    //      visit columns in view. Combined with ImGuiListClipper for rows, the cost of a table is then proportional to its visible cells.
     // - 5. Call EndTable()
     IMGUI_API bool          BeginTable(const char* str_id, int columns, ImGuiTableFlags flags = 0, const ImVec2& outer_size = ImVec2(0.0f, 0.0f), float inner_width = 0.0f);
     IMGUI_API void          EndTable();                                         // only call EndTable() if BeginTable() returns true!
     IMGUI_API void          TableNextRow(ImGuiTableRowFlags row_flags = 0, float min_row_height = 0.0f); // append into the first cell of a new row.
     IMGUI_API bool          TableNextColumn();                                  // append into the next column (or first column of next row if currently in last column). Return true when column is visible.
     IMGUI_API bool          TableSetColumnIndex(int column_n);                  // append into the specified column. Return true when column is visible.
+    IMGUI_API bool          TableNextVisibleColumn();                           // append into the next visible column of current row, skipping clipped/hidden columns entirely. Return false when reaching end of row (doesn't wrap-around). For very wide tables.
 
     // Tables: Headers & Columns declaration
     // - Use TableSetupColumn() to specify label, resizing policy, default width/weight, id, various other flags etc.
@@ -840,8 +851,12 @@ namespace ImGui
     //   When 'sort_specs->SpecsDirty == true' you should sort your data. It will be true when sorting specs have
     //   changed since last call, or the first time. Make sure to set 'SpecsDirty = false' after sorting,
     //   else you may wastefully sort your data every frame!
+    // - Sorting helper: TableSortItems() does the above for you and outputs indices of your items in sorted order (your items are not moved).
+    //   Keys are extracted once per item and compared without calling your code, the sort is stable and flipping the direction of
+    //   all sorted columns reuses previous indices in O(N). Set 'SpecsDirty = true' after your items changed to request a new sort.
     // - Functions args 'int column_n' treat the default value of -1 as the same as passing the current column index.
     IMGUI_API ImGuiTableSortSpecs*  TableGetSortSpecs();                        // get latest sort specs for the table (NULL if not sorting).  Lifetime: don't hold on this pointer over multiple frames or past any subsequent call to BeginTable().
+    IMGUI_API bool                  TableSortItems(ImU32* indices, int items_count, ImGuiTableSortKeyGetter get_key, void* user_data = NULL); // helper: when sort specs are dirty, output sorted order of your items into indices[items_count] and return true. See ImGuiTableSortKey.
     IMGUI_API int                   TableGetColumnCount();                      // return number of columns (value passed to BeginTable)
     IMGUI_API int                   TableGetColumnIndex();                      // return current column index.
     IMGUI_API int                   TableGetRowIndex();                         // return current row index.
@@ -1182,7 +1197,7 @@ enum ImGuiItemFlags_
 };
 
 // Flags for ImGui::InputText()
-// (Those are per-item flags. There are shared flags in ImGuiIO: io.ConfigInputTextCursorBlink and io.ConfigInputTextEnterKeepActive)
+// (Those are per-item flags. There are shared flags in ImGuiIO: io.ConfigInputTextCursorBlink, io.ConfigInputTextEnterKeepActive and io.ConfigInputTextUndoMemoryMax)
 enum ImGuiInputTextFlags_
 {
     // Basic filters (also see ImGuiInputTextFlags_CallbackCharFilter)
@@ -2102,6 +2117,16 @@ struct ImGuiTableColumnSortSpecs
     ImGuiTableColumnSortSpecs() { memset(this, 0, sizeof(*this)); }
 };
 
+// Sorting key of one item for one sorted column, filled by your ImGuiTableSortKeyGetter function for TableSortItems().
+// Set either Number or String. Items with a String key are sorted after items with a Number key (in ascending order).
+struct ImGuiTableSortKey
+{
+    double                      Number;             // Numeric key. Integers up to 2^53 are represented exactly.
+    const char*                 String;             // String key, compared with strcmp(). Must stay valid until TableSortItems() returns.
+
+    ImGuiTableSortKey()         { Number = 0.0; String = NULL; }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Helpers: Debug log, memory allocations macros, ImVector<>
 //-----------------------------------------------------------------------------
@@ -2352,6 +2377,7 @@ struct ImGuiIO
     bool        ConfigInputTrickleEventQueue;   // = true           // Enable input queue trickling: some types of events submitted during the same frame (e.g. button down + up) will be spread over multiple frames, improving interactions with low framerates.
     bool        ConfigInputTextCursorBlink;     // = true           // Enable blinking cursor (optional as some users consider it to be distracting).
     bool        ConfigInputTextEnterKeepActive; // = false          // [BETA] Pressing Enter will keep item active and select contents (single-line only).
+    int         ConfigInputTextUndoMemoryMax;   // = 1 MB           // Maximum memory used by undo/redo history of the active InputText(), in bytes. Oldest records are discarded when exceeded. Set to 0 to disable undo.
     bool        ConfigDragClickToInputText;     // = false          // [BETA] Enable turning DragXXX widgets into text input with a simple mouse click-release (without moving). Not desirable on devices without a keyboard.
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly;  // = false      // Enable allowing to move windows only when clicking on their title bar. Does not apply to windows without a title bar.
@@ -2454,6 +2480,20 @@ struct ImGuiIO
     IMGUI_API void  ClearInputCharacters();                                 // [Obsoleted in 1.89.8] Clear the current frame text input buffer. Now included within ClearInputKeys().
 #endif
 
+    // Input Functions: thread-safe variants
+    // - Call InitThreadSafeEventsQueue() once from the main thread, before any other thread may call the functions below.
+    // - They may then be called concurrently from any number of threads (e.g. a platform or input device thread). They are lock-free and return false if the queue is full.
+    // - Events are forwarded in submission order to the functions above at the beginning of NewFrame(), after events queued directly on the main thread.
+    // - Mouse events carry their own ImGuiMouseSource, as AddMouseSourceEvent() wouldn't be ordered between threads.
+    IMGUI_API void  InitThreadSafeEventsQueue(int capacity = 1024);        // Allocate queue for thread-safe functions (capacity is rounded up to a power of two). Call with 0 to free it.
+    IMGUI_API bool  AddKeyEventThreadSafe(ImGuiKey key, bool down);
+    IMGUI_API bool  AddKeyAnalogEventThreadSafe(ImGuiKey key, bool down, float v);
+    IMGUI_API bool  AddMousePosEventThreadSafe(float x, float y, ImGuiMouseSource source = ImGuiMouseSource_Mouse);
+    IMGUI_API bool  AddMouseButtonEventThreadSafe(int button, bool down, ImGuiMouseSource source = ImGuiMouseSource_Mouse);
+    IMGUI_API bool  AddMouseWheelEventThreadSafe(float wheel_x, float wheel_y, ImGuiMouseSource source = ImGuiMouseSource_Mouse);
+    IMGUI_API bool  AddFocusEventThreadSafe(bool focused);
+    IMGUI_API bool  AddInputCharacterThreadSafe(unsigned int c);
+
     //------------------------------------------------------------------
     // Output - Updated by NewFrame() or EndFrame()/Render()
     // (when reading from the io.WantCaptureMouse, io.WantCaptureKeyboard flags to dispatch your inputs, it is
@@ -2669,6 +2709,7 @@ struct ImGuiTextFilter
     IMGUI_API           ImGuiTextFilter(const char* default_filter = "");
     IMGUI_API bool      Draw(const char* label = "Filter (inc,-exc)", float width = 0.0f);  // Helper calling InputText+Build
     IMGUI_API bool      PassFilter(const char* text, const char* text_end = NULL) const;
+    IMGUI_API int       PassFilterBatch(const char* const* items, int items_count, ImU32* out_bits) const; // Test 'items_count' strings, set bit n of 'out_bits' (sized (items_count+31)/32) for each passing item. Return number of passing items. Build a list of passing indices from it to use with ImGuiListClipper.
     IMGUI_API void      Build();
     void                Clear()          { InputBuf[0] = 0; Build(); }
     bool                IsActive() const { return !Filters.empty(); }
@@ -2684,8 +2725,17 @@ struct ImGuiTextFilter
         bool            empty() const                   { return b == e; }
         IMGUI_API void  split(char separator, ImVector<ImGuiTextRange>* out) const;
     };
+    struct ImGuiTextTerm
+    {
+        const char*     Str;                // Needle, without the '-' prefix of exclusion terms
+        int             Len;
+        char            FirstOr, FirstVal;  // Case-folding of first and last characters, see ImStristr()
+        char            LastOr, LastVal;
+        bool            Exclude;
+    };
     char                    InputBuf[256];
     ImVector<ImGuiTextRange>Filters;
+    ImVector<ImGuiTextTerm> Terms;          // Non-empty terms of Filters[], compiled by Build() for PassFilter()
     int                     CountGrep;
 };
 
@@ -2710,6 +2760,37 @@ struct ImGuiTextBuffer
     IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
 };
 
+// Helper: Maintain a line index for a text buffer you own (e.g. a log stored in a ImGuiTextBuffer)
+// - Pass it to TextUnformatted(text, text_end, &index) to display large text in O(visible lines): the index is extended as the text grows.
+//   The text is expected to be append-only: call clear() if it was modified in other ways.
+// - layout() caches the widest line and, when word-wrapping, the start of each visual line. It is rebuilt when font, size or wrap width change.
+//   The last line is re-laid out on every call as it may still be growing.
+// - You may also call append() yourself and use get_line_begin()/get_line_end() to access lines, e.g. with ImGuiListClipper.
+struct ImGuiTextIndex
+{
+    ImVector<int>   LineOffsets;
+    int             EndOffset;                              // Because we don't own text buffer we need to maintain EndOffset (may bake in LineOffsets?)
+
+    // Layout cache (output of layout())
+    ImVector<int>   WrappedLineOffsets;                     // Start offset of each visual line when word-wrapping
+    float           MaxLineWidth;                           // Width of widest (visual) line
+    ImFont*         LayoutFont;
+    float           LayoutFontSize;
+    float           LayoutWrapWidth;
+    int             LayoutLinesCommitted;                   // Number of LineOffsets[] entries whose layout is final (all but the last line)
+    int             LayoutWrappedLinesCommitted;
+    float           LayoutMaxLineWidthCommitted;
+
+    ImGuiTextIndex()                                        { EndOffset = 0; LayoutFontSize = LayoutWrapWidth = 0.0f; clear_layout(); }
+    void            clear()                                 { LineOffsets.clear(); EndOffset = 0; clear_layout(); }
+    void            clear_layout()                          { WrappedLineOffsets.clear(); MaxLineWidth = 0.0f; LayoutFont = NULL; LayoutLinesCommitted = LayoutWrappedLinesCommitted = 0; LayoutMaxLineWidthCommitted = 0.0f; }
+    int             size()                                  { return LineOffsets.Size; }
+    const char*     get_line_begin(const char* base, int n) { return base + LineOffsets[n]; }
+    const char*     get_line_end(const char* base, int n)   { int end = (n + 1 < LineOffsets.Size) ? (LineOffsets[n + 1] - 1) : (EndOffset > LineOffsets[n] && base[EndOffset - 1] == '\n') ? EndOffset - 1 : EndOffset; return base + end; } // Exclude trailing \n of last line
+    IMGUI_API void  append(const char* base, int old_size, int new_size);
+    IMGUI_API void  layout(const char* base, ImFont* font, float font_size, float wrap_width);
+};
+
 // [Internal] Key+Value for ImGuiStorage
 struct ImGuiStoragePair
 {
@@ -2724,6 +2805,7 @@ struct ImGuiStoragePair
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
 // This is optimized for efficient lookup (dichotomy into a contiguous buffer) and rare insertion (typically tied to user interactions aka max once a frame)
+// With '#define IMGUI_USE_HASHED_STORAGE' in imconfig.h, pairs are appended unsorted and indexed by an open-addressing hash table: lookup and insertion are O(1).
 // You can use it as custom user storage for temporary values. Declare your own storage if, for example:
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
@@ -2732,11 +2814,21 @@ struct ImGuiStorage
 {
     // [Internal]
     ImVector<ImGuiStoragePair>      Data;
+#ifdef IMGUI_USE_HASHED_STORAGE
+    ImVector<ImGuiStoragePair>      _Index;         // Robin Hood hash table: { key, index into Data }, val_i == -1 for an empty slot. Size is a power of two.
+    int                             _IndexedCount;  // Data.Size when _Index was last updated. Rebuilt on mismatch (e.g. Data was modified directly).
+    ImGuiStorage()                  { _IndexedCount = 0; }
+#endif
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
+    // - With IMGUI_USE_HASHED_STORAGE: if you modify Data directly, call BuildSortByKey() afterwards to rebuild the index (lookups are O(N) until then).
+#ifdef IMGUI_USE_HASHED_STORAGE
+    void                Clear() { Data.clear(); _Index.clear(); _IndexedCount = 0; }
+#else
     void                Clear() { Data.clear(); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2756,6 +2848,7 @@ struct ImGuiStorage
     IMGUI_API void**    GetVoidPtrRef(ImGuiID key, void* default_val = NULL);
 
     // Advanced: for quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+    // With IMGUI_USE_HASHED_STORAGE: this doesn't sort, only rebuilds the index.
     IMGUI_API void      BuildSortByKey();
     // Obsolete: use on your own storage if you know only integer are being stored (open/close all tree nodes)
     IMGUI_API void      SetAllInt(int val);
@@ -2785,6 +2878,12 @@ struct ImGuiStorage
 // - Clipper calculate the actual range of elements to display based on the current clipping rectangle, position the cursor before the first visible element.
 // - User code submit visible elements.
 // - The clipper also handles various subtleties related to keyboard/gamepad navigation, wrapping etc.
+// Items of variable height:
+//   static ImGuiListClipperHeights heights; // Must persist across frames
+//   clipper.Begin(1000, &heights);
+//   (same loop as above)
+// - Each item is measured when it is displayed. Items not measured yet are assumed to be heights.DefaultHeight tall.
+// - Step() returns one item at a time so each item can be measured. Locating items from a scroll position is O(log N).
 struct ImGuiListClipper
 {
     ImGuiContext*   Ctx;                // Parent UI context
@@ -2795,12 +2894,15 @@ struct ImGuiListClipper
     float           StartPosY;          // [Internal] Cursor position at the time of Begin() or after table frozen rows are all processed
     double          StartSeekOffsetY;   // [Internal] Account for frozen rows in a table and initial loss of precision in very large windows.
     void*           TempData;           // [Internal] Internal data
+    ImGuiListClipperHeights* ItemsHeights; // [Internal] Heights of items, when using Begin() with variable item heights
 
     // items_count: Use INT_MAX if you don't know how many items you have (in which case the cursor won't be advanced in the final step, and you can call SeekCursorForItem() manually if you need)
     // items_height: Use -1.0f to be calculated automatically on first step. Otherwise pass in the distance between your items, typically GetTextLineHeightWithSpacing() or GetFrameHeightWithSpacing().
+    // items_heights: Storage for heights of items which are not all the same height. Must persist across frames.
     IMGUI_API ImGuiListClipper();
     IMGUI_API ~ImGuiListClipper();
     IMGUI_API void  Begin(int items_count, float items_height = -1.0f);
+    IMGUI_API void  Begin(int items_count, ImGuiListClipperHeights* items_heights);
     IMGUI_API void  End();             // Automatically called on the last call of Step() that returns false.
     IMGUI_API bool  Step();            // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those items.
 
@@ -2821,6 +2923,86 @@ struct ImGuiListClipper
 #endif
 };
 
+// Helper: Heights of items for ImGuiListClipper::Begin(items_count, items_heights)
+// - Stores one height per item + a Fenwick tree (binary indexed tree) of those, so the offset of an item and the item at a given offset are found in O(log N).
+// - Appending or removing items at the end (e.g. a growing log) is O(log N) per item. Call Clear() if items are inserted/removed elsewhere.
+// - You may call SetItemHeight() yourself, but ImGuiListClipper will measure every item it displays.
+struct ImGuiListClipperHeights
+{
+    ImVector<float>     Heights;        // Height of each item
+    ImVector<double>    Tree;           // Fenwick tree over Heights[] (1-based, Tree[0] unused). Using double to preserve precision with millions of items.
+    float               DefaultHeight;  // Height assumed for items not measured yet. Set to GetTextLineHeightWithSpacing() on first use if <= 0.0f.
+
+    ImGuiListClipperHeights()           { DefaultHeight = 0.0f; }
+    void                Clear()         { Heights.clear(); Tree.clear(); }
+    int                 Size() const    { return Heights.Size; }
+    IMGUI_API void      Resize(int items_count);                    // Add (using DefaultHeight) or remove items at the end.
+    IMGUI_API void      SetItemHeight(int item_n, float height);
+    IMGUI_API double    GetItemOffset(int item_n) const;            // Sum of heights of items [0..item_n). item_n may be == Size().
+    IMGUI_API int       FindItemAtOffset(double offset) const;      // Item containing 'offset', in [0..Size()], Size() if past the end.
+    double              GetTotalHeight() const                      { return GetItemOffset(Heights.Size); }
+};
+
+// Helper: Submit a large tree hierarchy with TreeNode() using ImGuiListClipper, only submitting rows in view.
+// - Without this, every open node and all its visible descendants need to be submitted every frame.
+// - This keeps a list of visible rows (nodes with all ancestors open). When a node is opened or closed, its descendants
+//   are inserted/removed from the list on the next Begin() call. Call Invalidate() to rebuild the whole list if your hierarchy
+//   changed or if you changed the open state of nodes yourself (e.g. with TreeNodeSetOpen()).
+// - Optionally set AdapterGetFlags to provide per-node flags, which are added to the ones passed to TreeNode(). They are
+//   also used when building rows, so nodes using ImGuiTreeNodeFlags_DefaultOpen have their descendants listed right away.
+// - Nodes are identified by a void* of your choice (e.g. a pointer to your node), also used as TreeNode() identifier:
+//   it must be unique within the tree and not NULL. The ID stack must be the same when calling Begin() and TreeNode().
+// - TreeNode() uses ImGuiTreeNodeFlags_NoTreePushOnOpen and indents the row according to its depth: do NOT call TreePop().
+//   ImGuiTreeNodeFlags_NavLeftJumpsBackHere is supported even if the parent row is clipped.
+// - Row indices can be passed to SetNextItemSelectionUserData(). As they change when nodes are opened/closed, store your
+//   selection using nodes, e.g. ImGuiSelectionBasicStorage with an adapter returning an identifier for 'Rows[idx].Node'.
+//   Call Begin() after BeginMultiSelect() and after applying its requests: rows indices kept by multi-select (RangeSrcItem,
+//   NavIdItem) are remapped when rows move, and ms_io->ItemsCount is updated. A RangeSrcItem hidden by closing one of its
+//   ancestors moves to that ancestor. They are not remapped on a full rebuild after Invalidate().
+//   Call 'tree.Clipper.IncludeItemByIndex()' after Begin() to prevent rows from being clipped, e.g. for ms_io->RangeSrcItem.
+// Usage:
+//   static ImGuiTreeClipper tree;  // Must persist across frames
+//   tree.UserData = my_tree;
+//   tree.AdapterGetChildCount = [](ImGuiTreeClipper* self, void* node) { ... }; // node == NULL for root
+//   tree.AdapterGetChild = [](ImGuiTreeClipper* self, void* node, int n) { ... };
+//   tree.Begin();
+//   while (tree.Step())
+//       for (int row_n = tree.DisplayStart; row_n < tree.DisplayEnd; row_n++)
+//           tree.TreeNode(row_n, ((MyNode*)tree.Rows[row_n].Node)->Name);
+struct ImGuiTreeClipperRow
+{
+    void*           Node;
+    int             Depth;
+    int             ChildCount;
+    bool            IsOpen;                 // Open state as of last submission, or last rebuild.
+};
+
+struct ImGuiTreeClipper
+{
+    void*           UserData;               // User data for use by adapter functions
+    int             (*AdapterGetChildCount)(ImGuiTreeClipper* self, void* node);       // Return number of children of 'node' (NULL for root)
+    void*           (*AdapterGetChild)(ImGuiTreeClipper* self, void* node, int n);     // Return n-th child of 'node' (NULL for root)
+    ImGuiTreeNodeFlags (*AdapterGetFlags)(ImGuiTreeClipper* self, void* node);         // [Optional] Return flags for 'node', e.g. ImGuiTreeNodeFlags_DefaultOpen
+    int             DisplayStart;           // First row to display, updated by each call to Step()
+    int             DisplayEnd;             // End of rows to display (exclusive)
+    ImVector<ImGuiTreeClipperRow> Rows;     // Visible rows
+    ImGuiListClipper Clipper;               // [Internal]
+    ImVector<int>   _ToggledRows;           // [Internal] Rows whose open state changed, applied on next Begin()
+    bool            _NeedRebuild;           // [Internal]
+    int             _NavRow;                // [Internal] Row holding NavId, or -1
+    int             _NavParentRow;          // [Internal] Parent row of _NavRow while a NavLeft request is pending, or -1
+    ImGuiID         _NavParentID;           // [Internal] Data of parent row stored for ImGuiTreeNodeFlags_NavLeftJumpsBackHere (~ImGuiTreeNodeStackData)
+    int             _NavParentItemFlags;    // [Internal]
+    ImVec2          _NavParentRectMin;      // [Internal]
+    ImVec2          _NavParentRectMax;      // [Internal]
+
+    IMGUI_API ImGuiTreeClipper();
+    IMGUI_API void  Begin();                // Update rows, then begin clipping them.
+    IMGUI_API bool  Step();                 // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can submit those rows.
+    IMGUI_API bool  TreeNode(int row_n, const char* label, ImGuiTreeNodeFlags flags = 0); // Submit row with TreeNodeEx() + track its open state. Returns TreeNodeEx() value (always true for leaf nodes).
+    inline void     Invalidate()            { _NeedRebuild = true; }
+};
+
 // Helpers: ImVec2/ImVec4 operators
 // - It is important that we are keeping those disabled by default so they don't leak in user space.
 // - This is in order to allow user enabling implicit cast operators between ImVec2/ImVec4 and their own types (using IM_VEC2_CLASS_EXTRA in imconfig.h)
@@ -2895,7 +3077,7 @@ struct ImColor
 };
 
 //-----------------------------------------------------------------------------
-// [SECTION] Multi-Select API flags and structures (ImGuiMultiSelectFlags, ImGuiSelectionRequestType, ImGuiSelectionRequest, ImGuiMultiSelectIO, ImGuiSelectionBasicStorage)
+// [SECTION] Multi-Select API flags and structures (ImGuiMultiSelectFlags, ImGuiSelectionRequestType, ImGuiSelectionRequest, ImGuiMultiSelectIO, ImGuiSelectionBasicStorage, ImGuiSelectionExternalStorage, ImGuiSelectionRangeStorage)
 //-----------------------------------------------------------------------------
 
 // Multi-selection system
@@ -3042,6 +3224,32 @@ struct ImGuiSelectionExternalStorage
     IMGUI_API void  ApplyRequests(ImGuiMultiSelectIO* ms_io);   // Apply selection requests by using AdapterSetItemSelected() calls
 };
 
+// Optional helper to store multi-selection state as a sorted list of disjoint ranges of indices + apply multi-selection requests.
+// - Cost of ApplyRequests() and memory usage depend on the number of ranges, not on the number of selected items:
+//   selecting 1M items with a SHIFT+Click or CTRL+A stores a single range, and never calls an adapter for each item.
+// - Contains() is O(log N) with N = number of ranges.
+// - Requires that ImGuiSelectionUserData holds item indices (as passed to SetNextItemSelectionUserData()), as they are stored directly.
+//   If your items move around (e.g. sorting, insertion) it is your responsibility to update or clear the selection.
+// - Iterate selection with 'void* it = NULL; int first, last; while (selection.GetNextSelectedRange(&it, &first, &last)) { ... }'
+// - USING THIS IS NOT MANDATORY. This is only a helper and not a required API.
+struct ImGuiSelectionRangeStorage
+{
+    // Members
+    int             Size;           //          // Number of selected items, maintained by this helper.
+    ImVector<int>   _Bounds;        // [Internal] Sorted boundaries: item 'idx' is selected if the number of boundaries <= idx is odd. Each selected range [first, last] is stored as 'first, last + 1'.
+
+    // Methods
+    IMGUI_API ImGuiSelectionRangeStorage();
+    IMGUI_API void  ApplyRequests(ImGuiMultiSelectIO* ms_io);   // Apply selection requests coming from BeginMultiSelect() and EndMultiSelect() functions. It uses 'items_count' passed to BeginMultiSelect() for SetAll requests.
+    IMGUI_API bool  Contains(int idx) const;                    // Query if an item index is in selection.
+    IMGUI_API void  Clear();                                    // Clear selection
+    IMGUI_API void  Swap(ImGuiSelectionRangeStorage& r);        // Swap two selections
+    IMGUI_API void  SetRangeSelected(int first, int last, bool selected); // Add/remove items first..last (inclusive) from selection (generally done by ApplyRequests() function)
+    IMGUI_API bool  GetNextSelectedRange(void** opaque_it, int* out_first, int* out_last); // Iterate selection ranges (inclusive)
+    inline void     SetItemSelected(int idx, bool selected)     { SetRangeSelected(idx, idx, selected); }
+    inline int      GetRangeCount() const                       { return _Bounds.Size / 2; } // Number of disjoint selected ranges
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Drawing API (ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListFlags, ImDrawList, ImDrawData)
 // Hold a series of drawing commands. The user provides a renderer for ImDrawData which essentially contains an array of ImDrawList.
@@ -3433,6 +3641,7 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_SignedDistanceField= 1 << 3,   // Rasterize glyphs as signed distance fields (stb_truetype builder only). A single baked size then renders crisply at any scale, but requires a renderer backend decoding the SDF (e.g. imgui_impl_opengl3). Implies ImFontAtlasFlags_NoBakedLines. OversampleH/V and RasterizerMultiply are ignored. Sets TexIsSdf when honored. Custom rects must only use 0x00/0xFF alpha.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -3503,6 +3712,8 @@ struct ImFontAtlas
     // You can request arbitrary rectangles to be packed into the atlas, for your own purposes.
     // - After calling Build(), you can query the rectangle position and render your pixels.
     // - If you render colored output, set 'atlas->TexPixelsUseColors = true' as this may help some backends decide of preferred texture format.
+    // - When atlas->TexIsSdf is set, the backend decodes the alpha channel of the whole texture as a distance field: only write alpha values
+    //   of 0x00 or 0xFF (saturated distances, decoded unchanged), as intermediate values would be thresholded around 0x80.
     // - You can also request your rectangles to be mapped as font glyph (given a font + Unicode point),
     //   so you can render e.g. custom colorful icons and use them as regular glyphs.
     // - Read docs/FONTS.md for more details about using colorful icons.
@@ -3523,6 +3734,7 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
+    int                         TexSdfSpread;       // Distance in pixels encoded on each side of glyph outlines when using ImFontAtlasFlags_SignedDistanceField. Defaults to 4. Edge value is 128 and each pixel of distance maps to 128/TexSdfSpread.
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
 
@@ -3530,10 +3742,12 @@ struct ImFontAtlas
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
     bool                        TexReady;           // Set when texture was built matching current font input
     bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format.
+    bool                        TexIsSdf;           // Set by the builder when glyphs were actually rasterized as signed distance fields (ImFontAtlasFlags_SignedDistanceField is ignored by e.g. the FreeType builder). Backends should read this rather than the flag.
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
     unsigned int*               TexPixelsRGBA32;    // 4 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight * 4
     int                         TexWidth;           // Texture width calculated during Build().
     int                         TexHeight;          // Texture height calculated during Build().
+    int                         TexPackedSurface;   // Surface of packed rectangles in pixels (padding included), calculated during Build(). Packing efficiency = TexPackedSurface / (TexWidth * TexHeight).
     ImVec2                      TexUvScale;         // = (1.0f/TexWidth, 1.0f/TexHeight)
     ImVec2                      TexUvWhitePixel;    // Texture coordinates to a white pixel
     ImVector<ImFont*>           Fonts;              // Hold all the fonts returned by AddFont*. Fonts[0] is the default font upon calling ImGui::NewFrame(), use ImGui::PushFont()/PopFont() to change the current font.
@@ -3596,6 +3810,7 @@ struct ImFont
     // 'wrap_width' enable automatic word-wrapping across multiple lines to fit into given width. 0.0f to disable.
     IMGUI_API ImVec2            CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end = NULL, const char** remaining = NULL) const; // utf8
     IMGUI_API const char*       CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const;
+    IMGUI_API const char*       CalcWordWrapLineEndA(float scale, const char* text, const char* text_end, float wrap_width, float* out_line_width) const; // Single pass: stop on '\n' or wrap point, output width of [text, return value) scaled by 'scale'.
     IMGUI_API void              RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, ImWchar c) const;
     IMGUI_API void              RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false) const;
 
@@ -1238,6 +1238,79 @@ static void ShowDemoWindowWidgets(ImGuiDemoWindowData* demo_data)
                 ImGui::Indent(ImGui::GetTreeNodeToLabelSpacing());
             ImGui::TreePop();
         }
+
+        IMGUI_DEMO_MARKER("Widgets/Tree Nodes/Clipped tree (100k nodes)");
+        if (ImGui::TreeNode("Clipped tree (100k nodes)"))
+        {
+            HelpMarker(
+                "ImGuiTreeClipper keeps a list of visible rows, so only rows in view are submitted instead of every open node.\n"
+                "Use Left/Right arrows to close/open nodes, Left on a child moves to its parent.\n"
+                "With multi-select, selection is stored by node so it is preserved when rows move.");
+
+            // Implicit tree of 111110 nodes: children of node N are nodes 10*N+1 to 10*N+10, root is 0.
+            // We use node index as node identifier, which is never NULL for actual nodes.
+            struct Funcs
+            {
+                static int GetChildCount(ImGuiTreeClipper*, void* node) { return ((intptr_t)node * 10 + 10 <= 111110) ? 10 : 0; }
+                static void* GetChild(ImGuiTreeClipper*, void* node, int n) { return (void*)((intptr_t)node * 10 + n + 1); }
+                static ImGuiTreeNodeFlags GetFlags(ImGuiTreeClipper*, void* node) { return ((intptr_t)node == 1) ? ImGuiTreeNodeFlags_DefaultOpen : ImGuiTreeNodeFlags_None; }
+            };
+            static ImGuiTreeClipper tree;
+            tree.AdapterGetChildCount = Funcs::GetChildCount;
+            tree.AdapterGetChild = Funcs::GetChild;
+            tree.AdapterGetFlags = Funcs::GetFlags; // Open "Node 1" by default
+
+            // Selection is stored by node (row indices change when nodes are opened/closed)
+            static bool use_multi_select = false;
+            static ImGuiSelectionBasicStorage selection;
+            selection.UserData = (void*)&tree;
+            selection.AdapterIndexToStorageId = [](ImGuiSelectionBasicStorage* self, int idx) { return (ImGuiID)(intptr_t)((ImGuiTreeClipper*)self->UserData)->Rows[idx].Node; };
+
+            ImGui::Checkbox("Multi-select", &use_multi_select);
+            ImGui::SameLine();
+            ImGui::Text("Visible rows: %d", tree.Rows.Size);
+            if (use_multi_select)
+            {
+                ImGui::SameLine();
+                ImGui::Text("Selected: %d", selection.Size);
+            }
+            if (ImGui::BeginChild("##Tree", ImVec2(-FLT_MIN, ImGui::GetFontSize() * 20), ImGuiChildFlags_FrameStyle | ImGuiChildFlags_ResizeY))
+            {
+                ImGuiTreeNodeFlags node_flags = ImGuiTreeNodeFlags_NavLeftJumpsBackHere | ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick;
+                ImGuiMultiSelectIO* ms_io = NULL;
+                if (use_multi_select)
+                {
+                    // Begin() must be called after BeginMultiSelect() and applying requests, as it remaps ms_io->RangeSrcItem when rows move.
+                    ms_io = ImGui::BeginMultiSelect(ImGuiMultiSelectFlags_ClearOnEscape | ImGuiMultiSelectFlags_BoxSelect1d, selection.Size, tree.Rows.Size);
+                    selection.ApplyRequests(ms_io);
+                    node_flags |= ImGuiTreeNodeFlags_SpanAvailWidth;
+                }
+                tree.Begin();
+                if (ms_io && ms_io->RangeSrcItem != -1)
+                    tree.Clipper.IncludeItemByIndex((int)ms_io->RangeSrcItem); // Ensure RangeSrc item is not clipped.
+                while (tree.Step())
+                    for (int row_n = tree.DisplayStart; row_n < tree.DisplayEnd; row_n++)
+                    {
+                        char label[32];
+                        sprintf(label, "Node %d", (int)(intptr_t)tree.Rows[row_n].Node);
+                        ImGuiTreeNodeFlags row_flags = node_flags;
+                        if (use_multi_select)
+                        {
+                            ImGui::SetNextItemSelectionUserData(row_n);
+                            if (selection.Contains((ImGuiID)(intptr_t)tree.Rows[row_n].Node))
+                                row_flags |= ImGuiTreeNodeFlags_Selected;
+                        }
+                        tree.TreeNode(row_n, label, row_flags);
+                    }
+                if (use_multi_select)
+                {
+                    ms_io = ImGui::EndMultiSelect();
+                    selection.ApplyRequests(ms_io);
+                }
+            }
+            ImGui::EndChild();
+            ImGui::TreePop();
+        }
         ImGui::TreePop();
     }
 
@@ -1325,6 +1398,11 @@ static void ShowDemoWindowWidgets(ImGuiDemoWindowData* demo_data)
                 ImGui::PopTextWrapPos();
             }
 
+            // CalcTextSize() with a wrap width measures wrapped text without submitting it
+            const char* text = "The quick brown fox jumps over the lazy dog.";
+            ImVec2 text_size = ImGui::CalcTextSize(text, NULL, false, wrap_width);
+            ImGui::Text("CalcTextSize(\"%s\") with wrap width %.0f: %.0f x %.0f", text, wrap_width, text_size.x, text_size.y);
+
             ImGui::TreePop();
         }
 
@@ -3363,6 +3441,47 @@ static void ShowDemoWindowMultiSelect(ImGuiDemoWindowData* demo_data)
             ImGui::TreePop();
         }
 
+        // Demonstrate storing selection as ranges of indices with ImGuiSelectionRangeStorage
+        IMGUI_DEMO_MARKER("Widgets/Selection State/Multi-Select (with clipper, 1M items)");
+        if (ImGui::TreeNode("Multi-Select (with clipper, 1M items)"))
+        {
+            // ImGuiSelectionRangeStorage stores indices passed to SetNextItemSelectionUserData() as ranges.
+            static ImGuiSelectionRangeStorage selection;
+
+            ImGui::Text("Added features:");
+            ImGui::BulletText("Using ImGuiSelectionRangeStorage: CTRL+A or SHIFT+Click don't iterate items.");
+
+            const int ITEMS_COUNT = 1000000;
+            ImGui::Text("Selection: %d/%d (%d ranges)", selection.Size, ITEMS_COUNT, selection.GetRangeCount());
+            if (ImGui::BeginChild("##Basket", ImVec2(-FLT_MIN, ImGui::GetFontSize() * 20), ImGuiChildFlags_FrameStyle | ImGuiChildFlags_ResizeY))
+            {
+                ImGuiMultiSelectFlags flags = ImGuiMultiSelectFlags_ClearOnEscape | ImGuiMultiSelectFlags_BoxSelect1d;
+                ImGuiMultiSelectIO* ms_io = ImGui::BeginMultiSelect(flags, selection.Size, ITEMS_COUNT);
+                selection.ApplyRequests(ms_io);
+
+                ImGuiListClipper clipper;
+                clipper.Begin(ITEMS_COUNT);
+                if (ms_io->RangeSrcItem != -1)
+                    clipper.IncludeItemByIndex((int)ms_io->RangeSrcItem); // Ensure RangeSrc item is not clipped.
+                while (clipper.Step())
+                {
+                    for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+                    {
+                        char label[64];
+                        sprintf(label, "Object %07d: %s", n, ExampleNames[n % IM_ARRAYSIZE(ExampleNames)]);
+                        bool item_is_selected = selection.Contains(n);
+                        ImGui::SetNextItemSelectionUserData(n);
+                        ImGui::Selectable(label, item_is_selected);
+                    }
+                }
+
+                ms_io = ImGui::EndMultiSelect();
+                selection.ApplyRequests(ms_io);
+            }
+            ImGui::EndChild();
+            ImGui::TreePop();
+        }
+
         // Demonstrate dynamic item list + deletion support using the BeginMultiSelect/EndMultiSelect API.
         // In order to support Deletion without any glitches you need to:
         // - (1) If items are submitted in their own scrolling area, submit contents size SetNextWindowContentSize() ahead of time to prevent one-frame readjustment of scrolling.
@@ -8769,20 +8888,21 @@ struct ExampleAppLog
 {
     ImGuiTextBuffer     Buf;
     ImGuiTextFilter     Filter;
-    ImVector<int>       LineOffsets; // Index to lines offset. We maintain this with AddLog() calls.
+    ImGuiTextIndex      LineIndex;   // Index to lines offset. We maintain this with AddLog() calls.
     bool                AutoScroll;  // Keep scrolling if already at the bottom.
+    bool                WordWrap;
 
     ExampleAppLog()
     {
         AutoScroll = true;
+        WordWrap = false;
         Clear();
     }
 
     void    Clear()
     {
         Buf.clear();
-        LineOffsets.clear();
-        LineOffsets.push_back(0);
+        LineIndex.clear();
     }
 
     void    AddLog(const char* fmt, ...) IM_FMTARGS(2)
@@ -8792,9 +8912,7 @@ struct ExampleAppLog
         va_start(args, fmt);
         Buf.appendfv(fmt, args);
         va_end(args);
-        for (int new_size = Buf.size(); old_size < new_size; old_size++)
-            if (Buf[old_size] == '\n')
-                LineOffsets.push_back(old_size + 1);
+        LineIndex.append(Buf.begin(), old_size, Buf.size());
     }
 
     void    Draw(const char* title, bool* p_open = NULL)
@@ -8809,6 +8927,7 @@ struct ExampleAppLog
         if (ImGui::BeginPopup("Options"))
         {
             ImGui::Checkbox("Auto-scroll", &AutoScroll);
+            ImGui::Checkbox("Word wrap", &WordWrap);
             ImGui::EndPopup();
         }
 
@@ -8840,14 +8959,22 @@ struct ExampleAppLog
                 // This is because we don't have random access to the result of our filter.
                 // A real application processing logs with ten of thousands of entries may want to store the result of
                 // search/filter.. especially if the filtering function is not trivial (e.g. reg-exp).
-                for (int line_no = 0; line_no < LineOffsets.Size; line_no++)
+                for (int line_no = 0; line_no < LineIndex.size(); line_no++)
                 {
-                    const char* line_start = buf + LineOffsets[line_no];
-                    const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
+                    const char* line_start = LineIndex.get_line_begin(buf, line_no);
+                    const char* line_end = LineIndex.get_line_end(buf, line_no);
                     if (Filter.PassFilter(line_start, line_end))
                         ImGui::TextUnformatted(line_start, line_end);
                 }
             }
+            else if (WordWrap)
+            {
+                // Lines wrapped over multiple visual lines don't have the same height, so we can't use the clipper.
+                // Passing our line index to TextUnformatted() allows it to only process visible lines, including when word-wrapping.
+                ImGui::PushTextWrapPos(0.0f);
+                ImGui::TextUnformatted(buf, buf_end, &LineIndex);
+                ImGui::PopTextWrapPos();
+            }
             else
             {
                 // The simplest and easy way to display the entire buffer:
@@ -8864,13 +8991,13 @@ struct ExampleAppLog
                 // anymore, which is why we don't use the clipper. Storing or skimming through the search result would make
                 // it possible (and would be recommended if you want to search through tens of thousands of entries).
                 ImGuiListClipper clipper;
-                clipper.Begin(LineOffsets.Size);
+                clipper.Begin(LineIndex.size());
                 while (clipper.Step())
                 {
                     for (int line_no = clipper.DisplayStart; line_no < clipper.DisplayEnd; line_no++)
                     {
-                        const char* line_start = buf + LineOffsets[line_no];
-                        const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
+                        const char* line_start = LineIndex.get_line_begin(buf, line_no);
+                        const char* line_end = LineIndex.get_line_end(buf, line_no);
                         ImGui::TextUnformatted(line_start, line_end);
                     }
                 }
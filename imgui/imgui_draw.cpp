@@ -778,7 +778,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         const bool use_texture = (Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (AA_SIZE == 1.0f);
 
         // We should never hit this, because NewFrame() doesn't set ImDrawListFlags_AntiAliasedLinesUseTex unless ImFontAtlasFlags_NoBakedLines is off
-        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines));
+        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField)));
 
         const int idx_count = use_texture ? (count * 6) : (thick_line ? count * 18 : count * 12);
         const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
@@ -2432,6 +2432,7 @@ ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
     TexGlyphPadding = 1;
+    TexSdfSpread = 4;
     PackIdMouseCursors = PackIdLines = -1;
 }
 
@@ -2474,6 +2475,7 @@ void    ImFontAtlas::ClearTexData()
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
     TexPixelsUseColors = false;
+    TexIsSdf = false;
     // Important: we leave TexReady untouched
 }
 
@@ -2802,6 +2804,47 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+// Render signed distance fields into the rectangles packed for one source font, and fill the stbtt_packedchar data
+// in the same way stbtt_PackFontRangesRenderIntoRects() would, so the rest of the build can use stbtt_GetPackedQuad().
+// Distance is encoded with 128 on the outline and increases by 128/sdf_spread per pixel toward the inside.
+static void ImFontAtlasBuildRenderSdfGlyphs(ImFontAtlas* atlas, ImFontBuildSrcData* src_tmp, int sdf_spread)
+{
+    const float font_size = src_tmp->PackRange.font_size;
+    const float scale = (font_size > 0.0f) ? stbtt_ScaleForPixelHeight(&src_tmp->FontInfo, font_size) : stbtt_ScaleForMappingEmToPixels(&src_tmp->FontInfo, -font_size);
+    const unsigned char on_edge_value = 128;
+    const float pixel_dist_scale = (float)on_edge_value / (float)sdf_spread;
+    for (int glyph_i = 0; glyph_i < src_tmp->GlyphsCount; glyph_i++)
+    {
+        const stbrp_rect& r = src_tmp->Rects[glyph_i];
+        stbtt_packedchar& pc = src_tmp->PackedChars[glyph_i];
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp->FontInfo, src_tmp->GlyphsList[glyph_i]);
+        int advance, lsb;
+        stbtt_GetGlyphHMetrics(&src_tmp->FontInfo, glyph_index_in_font, &advance, &lsb);
+        pc.xadvance = scale * advance;
+        if (!r.was_packed || r.w == 0 || r.h == 0)
+            continue;
+
+        int w = 0, h = 0, x_off = 0, y_off = 0;
+        unsigned char* bitmap = stbtt_GetGlyphSDF(&src_tmp->FontInfo, scale, glyph_index_in_font, sdf_spread, on_edge_value, pixel_dist_scale, &w, &h, &x_off, &y_off);
+        if (bitmap == NULL)
+            continue;
+        IM_ASSERT(w <= r.w && h <= r.h);
+        unsigned char* dst = atlas->TexPixelsAlpha8 + r.x + r.y * atlas->TexWidth;
+        for (int y = 0; y < h; y++, dst += atlas->TexWidth)
+            memcpy(dst, bitmap + y * w, (size_t)w);
+        stbtt_FreeSDF(bitmap, NULL);
+
+        pc.x0 = (unsigned short)r.x;
+        pc.y0 = (unsigned short)r.y;
+        pc.x1 = (unsigned short)(r.x + w);
+        pc.y1 = (unsigned short)(r.y + h);
+        pc.xoff = (float)x_off;
+        pc.yoff = (float)y_off;
+        pc.xoff2 = (float)(x_off + w);
+        pc.yoff2 = (float)(y_off + h);
+    }
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -2914,6 +2957,9 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
 
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
+    // When building a signed distance field atlas, glyphs are rasterized without oversampling and extended by TexSdfSpread on each side.
+    const bool build_sdf = (atlas->Flags & ImFontAtlasFlags_SignedDistanceField) != 0;
+    const int sdf_spread = build_sdf ? ImMax(atlas->TexSdfSpread, 1) : 0;
     int total_surface = 0;
     int buf_rects_out_n = 0;
     int buf_packedchars_out_n = 0;
@@ -2946,51 +2992,45 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             int x0, y0, x1, y1;
             const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
             IM_ASSERT(glyph_index_in_font != 0);
-            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+            if (build_sdf)
+            {
+                // Empty glyphs (e.g. space) don't get a distance field, see stbtt_GetGlyphSDF()
+                stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale, scale, 0, 0, &x0, &y0, &x1, &y1);
+                const bool is_empty = (x0 == x1 || y0 == y1);
+                src_tmp.Rects[glyph_i].w = (stbrp_coord)(is_empty ? 0 : x1 - x0 + sdf_spread * 2 + padding);
+                src_tmp.Rects[glyph_i].h = (stbrp_coord)(is_empty ? 0 : y1 - y0 + sdf_spread * 2 + padding);
+            }
+            else
+            {
+                stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+                src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
+                src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+            }
             total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
         }
     }
 
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
-    // User can override TexDesiredWidth and TexGlyphPadding if they wish, otherwise we use a simple heuristic to select the width based on expected surface.
-    const int surface_sqrt = (int)ImSqrt((float)total_surface) + 1;
+    // User can override TexDesiredWidth and TexGlyphPadding if they wish, otherwise we select the width leading to the smallest texture.
     atlas->TexHeight = 0;
-    if (atlas->TexDesiredWidth > 0)
-        atlas->TexWidth = atlas->TexDesiredWidth;
-    else
-        atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+    atlas->TexWidth = ImFontAtlasBuildCalcTexWidth(atlas, buf_rects.Data, buf_rects_out_n, total_surface);
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
-    const int TEX_HEIGHT_MAX = 1024 * 32;
     stbtt_pack_context spc = {};
-    stbtt_PackBegin(&spc, NULL, atlas->TexWidth, TEX_HEIGHT_MAX, 0, atlas->TexGlyphPadding, NULL);
+    stbtt_PackBegin(&spc, NULL, atlas->TexWidth, IM_FONTATLAS_TEX_HEIGHT_MAX, 0, atlas->TexGlyphPadding, NULL);
     ImFontAtlasBuildPackCustomRects(atlas, spc.pack_info);
 
-    // 6. Pack each source font. No rendering yet, we are working with rectangles in an infinitely tall texture at this point.
-    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbrp_pack_rects((stbrp_context*)spc.pack_info, src_tmp.Rects, src_tmp.GlyphsCount);
-
-        // Extend texture height and mark missing glyphs as non-packed so we won't render them.
-        // FIXME: We are not handling packing failure here (would happen if we got off TEX_HEIGHT_MAX or if a single if larger than TexWidth?)
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
-            if (src_tmp.Rects[glyph_i].was_packed)
-                atlas->TexHeight = ImMax(atlas->TexHeight, src_tmp.Rects[glyph_i].y + src_tmp.Rects[glyph_i].h);
-    }
+    // 6. Pack glyphs of all source fonts at once, so they are sorted by height together. No rendering yet, we are working with rectangles in an infinitely tall texture at this point.
+    ImFontAtlasBuildPackGlyphRects(atlas, spc.pack_info, buf_rects.Data, buf_rects_out_n);
 
     // 7. Allocate texture
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
     memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
+    atlas->TexIsSdf = build_sdf;
     spc.pixels = atlas->TexPixelsAlpha8;
     spc.height = atlas->TexHeight;
 
@@ -3002,10 +3042,13 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         if (src_tmp.GlyphsCount == 0)
             continue;
 
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
+        if (build_sdf)
+            ImFontAtlasBuildRenderSdfGlyphs(atlas, &src_tmp, sdf_spread);
+        else
+            stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
 
         // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        if (cfg.RasterizerMultiply != 1.0f && !build_sdf)
         {
             unsigned char multiply_table[256];
             ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
@@ -3102,11 +3145,86 @@ void ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* f
     }
 }
 
+// Pack custom rectangles and all glyph rectangles into a throwaway context, return resulting texture height.
+static int ImFontAtlasBuildPackDryRun(ImFontAtlas* atlas, int tex_width, const stbrp_rect* glyph_rects, int glyph_rects_count, ImVector<stbrp_rect>& tmp_rects, ImVector<stbrp_node>& tmp_nodes)
+{
+    tmp_nodes.resize(tex_width - atlas->TexGlyphPadding);
+    stbrp_context pack_context;
+    stbrp_init_target(&pack_context, tex_width - atlas->TexGlyphPadding, IM_FONTATLAS_TEX_HEIGHT_MAX - atlas->TexGlyphPadding, tmp_nodes.Data, tmp_nodes.Size);
+    stbrp_setup_heuristic(&pack_context, STBRP_HEURISTIC_Skyline_BF_sortHeight);
+
+    int tex_height = 0;
+    tmp_rects.resize(atlas->CustomRects.Size);
+    memset(tmp_rects.Data, 0, (size_t)tmp_rects.size_in_bytes());
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        tmp_rects[i].w = atlas->CustomRects[i].Width;
+        tmp_rects[i].h = atlas->CustomRects[i].Height;
+    }
+    for (int pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+        {
+            tmp_rects.resize(glyph_rects_count);
+            memcpy(tmp_rects.Data, glyph_rects, (size_t)tmp_rects.size_in_bytes());
+        }
+        if (tmp_rects.Size == 0)
+            continue;
+        stbrp_pack_rects(&pack_context, tmp_rects.Data, tmp_rects.Size);
+        for (const stbrp_rect& r : tmp_rects)
+        {
+            if (!r.was_packed)
+                return IM_FONTATLAS_TEX_HEIGHT_MAX * 2; // Failed to pack everything
+            tex_height = ImMax(tex_height, r.y + r.h);
+        }
+    }
+    return (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (tex_height + 1) : ImUpperPowerOfTwo(tex_height);
+}
+
+// Select texture width before packing glyphs. Returns TexDesiredWidth if specified.
+// Otherwise we start from a guess based on expected surface, then also try half and twice that width and keep the one leading to the smallest texture.
+int ImFontAtlasBuildCalcTexWidth(ImFontAtlas* atlas, const void* stbrp_glyph_rects_opaque, int glyph_rects_count, int total_surface)
+{
+    if (atlas->TexDesiredWidth > 0)
+        return atlas->TexDesiredWidth;
+
+    const int surface_sqrt = (int)ImSqrt((float)total_surface) + 1;
+    const int guess_width = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+
+    const stbrp_rect* glyph_rects = (const stbrp_rect*)stbrp_glyph_rects_opaque;
+    ImVector<stbrp_rect> tmp_rects;
+    ImVector<stbrp_node> tmp_nodes;
+    int best_width = guess_width;
+    int best_height = ImFontAtlasBuildPackDryRun(atlas, guess_width, glyph_rects, glyph_rects_count, tmp_rects, tmp_nodes);
+    const int candidate_widths[] = { guess_width / 2, guess_width * 2 };
+    for (int tex_width : candidate_widths)
+    {
+        if (tex_width < 512 || tex_width > 4096)
+            continue;
+        const int tex_height = ImFontAtlasBuildPackDryRun(atlas, tex_width, glyph_rects, glyph_rects_count, tmp_rects, tmp_nodes);
+        if (tex_height > IM_FONTATLAS_TEX_HEIGHT_MAX)
+            continue; // Never select a candidate width which fails packing
+        if (tex_height > IM_FONTATLAS_TEX_HEIGHT_PREFERRED_MAX && tex_height > best_height)
+            continue; // Avoid very tall textures
+        if ((ImS64)tex_width * tex_height < (ImS64)best_width * best_height)
+        {
+            best_width = tex_width;
+            best_height = tex_height;
+        }
+    }
+    return best_width;
+}
+
 void ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opaque)
 {
     stbrp_context* pack_context = (stbrp_context*)stbrp_context_opaque;
     IM_ASSERT(pack_context != NULL);
 
+    // All builders call this first on a freshly initialized context: select best-fit heuristic (default is bottom-left).
+    // The skyline packer keeps its state in the context, so further calls to stbrp_pack_rects() can insert more rectangles.
+    stbrp_setup_heuristic(pack_context, STBRP_HEURISTIC_Skyline_BF_sortHeight);
+    atlas->TexPackedSurface = 0;
+
     ImVector<ImFontAtlasCustomRect>& user_rects = atlas->CustomRects;
     IM_ASSERT(user_rects.Size >= 1); // We expect at least the default custom rects to be registered, else something went wrong.
 #ifdef __GNUC__
@@ -3129,6 +3247,26 @@ void ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opa
             user_rects[i].Y = (unsigned short)pack_rects[i].y;
             IM_ASSERT(pack_rects[i].w == user_rects[i].Width && pack_rects[i].h == user_rects[i].Height);
             atlas->TexHeight = ImMax(atlas->TexHeight, pack_rects[i].y + pack_rects[i].h);
+            atlas->TexPackedSurface += pack_rects[i].w * pack_rects[i].h;
+        }
+}
+
+// Pack glyph rectangles, extend texture height. Rectangles which couldn't be packed are left with was_packed == 0 so we won't render them.
+// FIXME: We are not handling packing failure here (would happen if we got off IM_FONTATLAS_TEX_HEIGHT_MAX or if a single if larger than TexWidth?)
+void ImFontAtlasBuildPackGlyphRects(ImFontAtlas* atlas, void* stbrp_context_opaque, void* stbrp_glyph_rects_opaque, int glyph_rects_count)
+{
+    stbrp_context* pack_context = (stbrp_context*)stbrp_context_opaque;
+    stbrp_rect* glyph_rects = (stbrp_rect*)stbrp_glyph_rects_opaque;
+    IM_ASSERT(pack_context != NULL);
+    if (glyph_rects_count == 0)
+        return;
+
+    stbrp_pack_rects(pack_context, glyph_rects, glyph_rects_count);
+    for (int i = 0; i < glyph_rects_count; i++)
+        if (glyph_rects[i].was_packed)
+        {
+            atlas->TexHeight = ImMax(atlas->TexHeight, glyph_rects[i].y + glyph_rects[i].h);
+            atlas->TexPackedSurface += glyph_rects[i].w * glyph_rects[i].h;
         }
 }
 
@@ -3194,7 +3332,7 @@ static void ImFontAtlasBuildRenderDefaultTexData(ImFontAtlas* atlas)
 
 static void ImFontAtlasBuildRenderLinesTexData(ImFontAtlas* atlas)
 {
-    if (atlas->Flags & ImFontAtlasFlags_NoBakedLines)
+    if (atlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField))
         return;
 
     // This generates a triangular shape in the texture, with the various line widths stacked on top of each other to allow interpolation between them
@@ -3266,7 +3404,7 @@ void ImFontAtlasBuildInit(ImFontAtlas* atlas)
     // The +2 here is to give space for the end caps, whilst height +1 is to accommodate the fact we have a zero-width row
     if (atlas->PackIdLines < 0)
     {
-        if (!(atlas->Flags & ImFontAtlasFlags_NoBakedLines))
+        if (!(atlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField)))
             atlas->PackIdLines = atlas->AddCustomRectRegular(IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 2, IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1);
     }
 }
@@ -3959,6 +4097,174 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     return s;
 }
 
+// Same wrapping rules as CalcWordWrapPositionA(), but stops on '\n' and outputs the width of the visual line, so callers don't need a second pass over the text.
+// - Returns the wrap point, the position of the '\n' or text_end. Continue from CalcWordWrapNextLineStartA() on the returned value.
+// - 'out_line_width' is scaled and accumulated in the same order as CalcTextSizeA() for identical results.
+const char* ImFont::CalcWordWrapLineEndA(float scale, const char* text, const char* text_end, float wrap_width, float* out_line_width) const
+{
+    float line_width = 0.0f;
+    float word_width = 0.0f;
+    float blank_width = 0.0f;
+    wrap_width /= scale; // We work with unscaled widths to avoid scaling every characters
+
+    // Scaled widths of [text, s), [text, word_end), [text, prev_word_end)
+    float s_width = 0.0f;
+    float word_end_width = 0.0f;
+    float prev_word_end_width = 0.0f;
+
+    const char* word_end = text;
+    const char* prev_word_end = NULL;
+    bool inside_word = true;
+
+    const char* s = text;
+    IM_ASSERT(text_end != NULL);
+    while (s < text_end)
+    {
+        unsigned int c = (unsigned int)*s;
+        const char* next_s;
+        if (c < 0x80)
+            next_s = s + 1;
+        else
+            next_s = s + ImTextCharFromUtf8(&c, s, text_end);
+
+        if (c < 32)
+        {
+            if (c == '\n')
+                break;
+            if (c == '\r')
+            {
+                s = next_s;
+                continue;
+            }
+        }
+
+        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX);
+        const float next_s_width = s_width + char_width * scale;
+        if (ImCharIsBlankW(c))
+        {
+            if (inside_word)
+            {
+                line_width += blank_width;
+                blank_width = 0.0f;
+                word_end = s;
+                word_end_width = s_width;
+            }
+            blank_width += char_width;
+            inside_word = false;
+        }
+        else
+        {
+            word_width += char_width;
+            if (inside_word)
+            {
+                word_end = next_s;
+                word_end_width = next_s_width;
+            }
+            else
+            {
+                prev_word_end = word_end;
+                prev_word_end_width = word_end_width;
+                line_width += word_width + blank_width;
+                word_width = blank_width = 0.0f;
+            }
+
+            // Allow wrapping after punctuation.
+            inside_word = (c != '.' && c != ',' && c != ';' && c != '!' && c != '?' && c != '\"');
+        }
+
+        // We ignore blank width at the end of the line (they can be skipped)
+        if (line_width + word_width > wrap_width)
+        {
+            // Words that cannot possibly fit within an entire line will be cut anywhere.
+            if (word_width < wrap_width)
+            {
+                s = prev_word_end ? prev_word_end : word_end;
+                s_width = prev_word_end ? prev_word_end_width : word_end_width;
+            }
+            break;
+        }
+
+        s = next_s;
+        s_width = next_s_width;
+    }
+
+    // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
+    if (s == text && s < text_end && *s != '\n')
+    {
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&c, s, text_end);
+        s_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX) * scale;
+    }
+
+    *out_line_width = s_width;
+    return s;
+}
+
+// Lay out a word-wrapped text in a single pass, optionally outputting visual lines.
+// Returns the same value as font->CalcTextSizeA(size, FLT_MAX, wrap_width, text_begin, text_end).
+ImVec2 ImFontCalcWrapLayout(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end, ImVector<ImFontWrapLine>* out_lines)
+{
+    IM_ASSERT(wrap_width > 0.0f);
+    const float line_height = size;
+    const float scale = size / font->FontSize;
+
+    ImVec2 text_size = ImVec2(0, 0);
+    float line_width = 0.0f;
+
+    const char* s = text_begin;
+    while (s < text_end)
+    {
+        const char* line_end = font->CalcWordWrapLineEndA(scale, s, text_end, wrap_width, &line_width);
+        if (out_lines)
+        {
+            ImFontWrapLine line = { (int)(s - text_begin), (int)(line_end - text_begin), line_width };
+            out_lines->push_back(line);
+        }
+        if (line_end == text_end)
+            break;
+        if (text_size.x < line_width)
+            text_size.x = line_width;
+        text_size.y += line_height;
+        line_width = 0.0f;
+        s = CalcWordWrapNextLineStartA(line_end, text_end); // Wrapping skips upcoming blanks, '\n' skips itself
+    }
+
+    if (text_size.x < line_width)
+        text_size.x = line_width;
+
+    if (line_width > 0 || text_size.y == 0.0f)
+        text_size.y += line_height;
+
+    return text_size;
+}
+
+// Return cached layout if it matches, NULL otherwise.
+const ImFontWrapLayout* ImFontFindWrapLayout(const ImFontWrapLayout* cache, const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end)
+{
+    IM_ASSERT(text_end != NULL);
+    if (cache->Font != font || cache->FontSize != size || cache->WrapWidth != wrap_width || cache->Text != text_begin || cache->TextLen != (int)(text_end - text_begin))
+        return NULL;
+    return cache;
+}
+
+// Lay out the text into the cache. This is always recomputed so that a buffer reused for another text of the same length
+// (e.g. g.TempBuffer) refreshes the cache before the following RenderText().
+const ImFontWrapLayout* ImFontUpdateWrapLayout(ImFontWrapLayout* cache, const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end)
+{
+    IM_ASSERT(text_end != NULL);
+    cache->Lines.resize(0);
+    cache->Size = ImFontCalcWrapLayout(font, size, wrap_width, text_begin, text_end, &cache->Lines);
+    cache->Font = font;
+    cache->FontSize = size;
+    cache->WrapWidth = wrap_width;
+    cache->Text = text_begin;
+    cache->TextLen = (int)(text_end - text_begin);
+    return cache;
+}
+
 ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
 {
     if (!text_end)
@@ -3966,11 +4272,18 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
 
     const float line_height = size;
     const float scale = size / FontSize;
+    const bool word_wrap_enabled = (wrap_width > 0.0f);
+
+    // Word-wrapping without a width limit: single pass over the text.
+    if (word_wrap_enabled && max_width == FLT_MAX)
+    {
+        if (remaining)
+            *remaining = text_end;
+        return ImFontCalcWrapLayout(this, size, wrap_width, text_begin, text_end, NULL);
+    }
 
     ImVec2 text_size = ImVec2(0, 0);
     float line_width = 0.0f;
-
-    const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
 
     const char* s = text_begin;
@@ -4069,26 +4382,41 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     const float line_height = FontSize * scale;
     const bool word_wrap_enabled = (wrap_width > 0.0f);
 
+    // Reuse word-wrapped layout if the same text was just measured with ImGui::CalcTextSize()
+    const ImFontWrapLayout* wrap_layout = NULL;
+    if (word_wrap_enabled && draw_list->_Data != NULL)
+        wrap_layout = ImFontFindWrapLayout(&draw_list->_Data->WrapLayoutCache, this, size, wrap_width, text_begin, text_end);
+    int wrap_line_n = 0;
+
     // Fast-forward to first visible line
     const char* s = text_begin;
     if (y + line_height < clip_rect.y)
+    {
+        if (wrap_layout)
+        {
+            while (y + line_height < clip_rect.y && wrap_line_n < wrap_layout->Lines.Size)
+            {
+                y += line_height;
+                wrap_line_n++;
+            }
+            s = (wrap_line_n < wrap_layout->Lines.Size) ? text_begin + wrap_layout->Lines[wrap_line_n].Begin : text_end;
+        }
         while (y + line_height < clip_rect.y && s < text_end)
         {
-            const char* line_end = (const char*)memchr(s, '\n', text_end - s);
             if (word_wrap_enabled)
             {
-                // FIXME-OPT: This is not optimal as do first do a search for \n before calling CalcWordWrapPositionA().
-                // If the specs for CalcWordWrapPositionA() were reworked to optionally return on \n we could combine both.
-                // However it is still better than nothing performing the fast-forward!
-                s = CalcWordWrapPositionA(scale, s, line_end ? line_end : text_end, wrap_width);
+                float line_width;
+                s = CalcWordWrapLineEndA(scale, s, text_end, wrap_width, &line_width);
                 s = CalcWordWrapNextLineStartA(s, text_end);
             }
             else
             {
+                const char* line_end = (const char*)memchr(s, '\n', text_end - s);
                 s = line_end ? line_end + 1 : text_end;
             }
             y += line_height;
         }
+    }
 
     // For large text, scan for the last visible line in order to avoid over-reserving in the call to PrimReserve()
     // Note that very large horizontal line will still be affected by the issue (e.g. a one megabyte string buffer without a newline will likely crash atm)
@@ -4123,9 +4451,15 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     {
         if (word_wrap_enabled)
         {
-            // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
+            // Calculate how far we can render (stops on '\n', which is then handled as a wrap point)
             if (!word_wrap_eol)
-                word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - start_x));
+            {
+                float line_width;
+                if (wrap_layout && wrap_line_n < wrap_layout->Lines.Size)
+                    word_wrap_eol = text_begin + wrap_layout->Lines[wrap_line_n++].End;
+                else
+                    word_wrap_eol = CalcWordWrapLineEndA(scale, s, text_end, wrap_width - (x - start_x), &line_width);
+            }
 
             if (s >= word_wrap_eol)
             {
@@ -4134,7 +4468,7 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
                 if (y > clip_rect.w)
                     break; // break out of main loop
                 word_wrap_eol = NULL;
-                s = CalcWordWrapNextLineStartA(s, text_end); // Wrapping skips upcoming blanks
+                s = CalcWordWrapNextLineStartA(s, text_end); // Wrapping skips upcoming blanks, '\n' skips itself
                 continue;
             }
         }
@@ -61,6 +61,20 @@ Index of this file:
 #if (defined __SSE__ || defined __x86_64__ || defined _M_X64 || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))) && !defined(IMGUI_DISABLE_SSE)
 #define IMGUI_ENABLE_SSE
 #include <immintrin.h>
+#if (defined __AVX__ || defined __SSE4_2__)
+#define IMGUI_ENABLE_SSE4_2
+#include <nmmintrin.h>
+#endif
+#endif
+
+// Enable hardware CRC32C for ImHashData()/ImHashStr() if available (only when using CRC32C, see IMGUI_USE_CRC32C in imconfig.h).
+// Emscripten has partial SSE 4.2 support where _mm_crc32_u32 is not available.
+#if defined(IMGUI_ENABLE_SSE4_2) && defined(IMGUI_USE_CRC32C) && !defined(__EMSCRIPTEN__)
+#define IMGUI_ENABLE_SSE4_2_CRC
+#endif
+#if defined(__ARM_FEATURE_CRC32) && defined(__aarch64__) && !defined(__ARM_BIG_ENDIAN) && defined(IMGUI_USE_CRC32C)
+#define IMGUI_ENABLE_ARM_CRC32
+#include <arm_acle.h>
 #endif
 
 // Visual Studio warnings
@@ -338,7 +352,6 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 // - Helper: ImSpan<>, ImSpanAllocator<>
 // - Helper: ImPool<>
 // - Helper: ImChunkStream<>
-// - Helper: ImGuiTextIndex
 // - Helper: ImGuiStorage
 //-----------------------------------------------------------------------------
 
@@ -346,11 +359,6 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImGuiID seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImGuiID seed = 0);
 
-// Helpers: Sorting
-#ifndef ImQsort
-static inline void      ImQsort(void* base, size_t count, size_t size_of_element, int(IMGUI_CDECL *compare_func)(void const*, void const*)) { if (count > 1) qsort(base, count, size_of_element, compare_func); }
-#endif
-
 // Helpers: Color Blending
 IMGUI_API ImU32         ImAlphaBlendColors(ImU32 col_a, ImU32 col_b);
 
@@ -487,6 +495,133 @@ static inline bool   ImIsFloatAboveGuaranteedIntegerPrecision(float f)
 static inline float  ImExponentialMovingAverage(float avg, float sample, int n) { avg -= avg / n; avg += sample / n; return avg; }
 IM_MSVC_RUNTIME_CHECKS_RESTORE
 
+// Helpers: Sorting
+// - ImQsort(): qsort() wrapper, comparison function is called indirectly.
+// - ImSort<T, CMP>(): introsort (quicksort + heapsort fallback + insertion sort for small ranges), comparison function is inlined.
+//   CMP returns <0, 0 or >0 like a qsort() comparer but takes typed references. Not stable. Robust to inconsistent comparers (no out of bounds access).
+// - ImSortRadix<T, GETKEY>(): LSD radix sort on a 32-bit unsigned key (e.g. ImGuiID). Stable. Requires a temporary buffer of 'count' elements.
+#ifndef ImQsort
+static inline void      ImQsort(void* base, size_t count, size_t size_of_element, int(IMGUI_CDECL *compare_func)(void const*, void const*)) { if (count > 1) qsort(base, count, size_of_element, compare_func); }
+#endif
+template<typename T, int (*CMP)(const T&, const T&)>
+static inline void ImSortInsertion(T* first, T* last)
+{
+    for (T* it = first + 1; it < last; it++)
+    {
+        T v = *it;
+        T* dst = it;
+        for (; dst > first && CMP(v, dst[-1]) < 0; dst--)
+            *dst = dst[-1];
+        *dst = v;
+    }
+}
+template<typename T, int (*CMP)(const T&, const T&)>
+static inline void ImSortHeapSiftDown(T* data, int root, int count)
+{
+    for (int child = root * 2 + 1; child < count; root = child, child = root * 2 + 1)
+    {
+        if (child + 1 < count && CMP(data[child], data[child + 1]) < 0)
+            child++;
+        if (CMP(data[root], data[child]) >= 0)
+            return;
+        ImSwap(data[root], data[child]);
+    }
+}
+template<typename T, int (*CMP)(const T&, const T&)>
+static void ImSortIntro(T* first, T* last, int depth_limit)
+{
+    while (last - first > 16)
+    {
+        const int count = (int)(last - first);
+        if (depth_limit-- == 0)
+        {
+            for (int n = count / 2 - 1; n >= 0; n--)
+                ImSortHeapSiftDown<T, CMP>(first, n, count);
+            for (int n = count - 1; n > 0; n--)
+            {
+                ImSwap(first[0], first[n]);
+                ImSortHeapSiftDown<T, CMP>(first, 0, n);
+            }
+            return;
+        }
+
+        // Median of three, then Hoare partition around a copy of the pivot
+        T* mid = first + (count - 1) / 2;
+        if (CMP(*mid, *first) < 0) ImSwap(*mid, *first);
+        if (CMP(last[-1], *mid) < 0) { ImSwap(last[-1], *mid); if (CMP(*mid, *first) < 0) ImSwap(*mid, *first); }
+        const T pivot = *mid;
+        T* i = first - 1;
+        T* j = last;
+        for (;;)
+        {
+            do { i++; } while (i < last - 1 && CMP(*i, pivot) < 0);
+            do { j--; } while (j > first && CMP(pivot, *j) < 0);
+            if (i >= j)
+                break;
+            ImSwap(*i, *j);
+        }
+
+        // Recurse into smaller side, loop on larger side
+        T* split = j + 1;
+        if (split - first < last - split)
+        {
+            ImSortIntro<T, CMP>(first, split, depth_limit);
+            first = split;
+        }
+        else
+        {
+            ImSortIntro<T, CMP>(split, last, depth_limit);
+            last = split;
+        }
+    }
+    ImSortInsertion<T, CMP>(first, last);
+}
+template<typename T, int (*CMP)(const T&, const T&)>
+static inline void ImSort(T* data, int count)
+{
+    if (count < 2)
+        return;
+    int depth_limit = 0;
+    for (int n = count; n > 1; n >>= 1)
+        depth_limit += 2;
+    ImSortIntro<T, CMP>(data, data + count, depth_limit);
+}
+template<typename T, ImU32 (*GETKEY)(const T&)>
+static void ImSortRadix(T* data, int count, T* temp)
+{
+    if (count < 2)
+        return;
+    int histograms[4][256] = {};
+    for (int n = 0; n < count; n++)
+    {
+        const ImU32 key = GETKEY(data[n]);
+        histograms[0][key & 0xFF]++;
+        histograms[1][(key >> 8) & 0xFF]++;
+        histograms[2][(key >> 16) & 0xFF]++;
+        histograms[3][key >> 24]++;
+    }
+    T* src = data;
+    T* dst = temp;
+    for (int pass = 0; pass < 4; pass++)
+    {
+        const int shift = pass * 8;
+        int* histogram = histograms[pass];
+        if (histogram[(GETKEY(src[0]) >> shift) & 0xFF] == count) // All keys share this byte: skip pass
+            continue;
+        for (int bucket = 0, offset = 0; bucket < 256; bucket++)
+        {
+            const int bucket_count = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucket_count;
+        }
+        for (int n = 0; n < count; n++)
+            dst[histogram[(GETKEY(src[n]) >> shift) & 0xFF]++] = src[n];
+        ImSwap(src, dst);
+    }
+    if (src != data)
+        memcpy(data, src, (size_t)count * sizeof(T));
+}
+
 // Helpers: Geometry
 IMGUI_API ImVec2     ImBezierCubicCalc(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, float t);
 IMGUI_API ImVec2     ImBezierCubicClosestPoint(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, const ImVec2& p, int num_segments);       // For curves with explicit number of segments
@@ -660,6 +795,71 @@ struct ImSpanAllocator
     inline void  GetSpan(int n, ImSpan<T>* span)    { span->set((T*)GetSpanPtrBegin(n), (T*)GetSpanPtrEnd(n)); }
 };
 
+// Helper: ImVectorInline<>
+// Small-buffer-optimized subset of ImVector<>: the first N elements are stored inline, larger sizes spill to the heap.
+// Use for tiny hot stacks to avoid an allocation per owner and a pointer indirection.
+// - Zero-cleared state is valid (e.g. ImGuiWindow constructor memset). Like ImVector, doesn't call constructors/destructors.
+// - Storage moves when crossing N: as with ImVector, don't keep pointers across push_back()/resize().
+// - Only used in internal structures: public structures keep ImVector<> so their layout doesn't change.
+template<typename T, int N>
+struct ImVectorInline
+{
+    int                 Size;
+    int                 HeapCapacity;   // 0 while using InlineData[]
+    T*                  HeapData;
+    T                   InlineData[N];
+
+    inline ImVectorInline()                                         { Size = HeapCapacity = 0; HeapData = NULL; }
+    inline ImVectorInline(const ImVectorInline<T, N>& src)          { Size = HeapCapacity = 0; HeapData = NULL; operator=(src); }
+    inline ImVectorInline<T, N>& operator=(const ImVectorInline<T, N>& src) { resize(0); resize(src.Size); memcpy(data(), src.data(), (size_t)Size * sizeof(T)); return *this; }
+    inline ~ImVectorInline()                                        { if (HeapData) IM_FREE(HeapData); }
+
+    inline void         clear()                                     { if (HeapData) IM_FREE(HeapData); Size = HeapCapacity = 0; HeapData = NULL; }
+    inline bool         empty() const                               { return Size == 0; }
+    inline int          capacity() const                            { return HeapData ? HeapCapacity : N; }
+    inline T*           data()                                      { return HeapData ? HeapData : InlineData; }
+    inline const T*     data() const                                { return HeapData ? HeapData : InlineData; }
+    inline T&           operator[](int i)                           { IM_ASSERT(i >= 0 && i < Size); return data()[i]; }
+    inline const T&     operator[](int i) const                     { IM_ASSERT(i >= 0 && i < Size); return data()[i]; }
+    inline T*           begin()                                     { return data(); }
+    inline const T*     begin() const                               { return data(); }
+    inline T*           end()                                       { return data() + Size; }
+    inline const T*     end() const                                 { return data() + Size; }
+    inline T&           back()                                      { IM_ASSERT(Size > 0); return data()[Size - 1]; }
+    inline const T&     back() const                                { IM_ASSERT(Size > 0); return data()[Size - 1]; }
+
+    inline void         reserve(int new_capacity)                   { if (new_capacity <= capacity()) return; T* new_data = (T*)IM_ALLOC((size_t)new_capacity * sizeof(T)); memcpy(new_data, data(), (size_t)Size * sizeof(T)); if (HeapData) IM_FREE(HeapData); HeapData = new_data; HeapCapacity = new_capacity; }
+    inline void         resize(int new_size)                        { if (new_size > capacity()) reserve(ImMax(new_size, capacity() * 2)); Size = new_size; }
+    inline void         push_back(const T& v)                       { if (Size == capacity()) { T tmp = v; reserve(Size * 2); data()[Size++] = tmp; return; } data()[Size++] = v; }
+    inline void         pop_back()                                  { IM_ASSERT(Size > 0); Size--; }
+};
+
+// Helper: ImLinearAllocator
+// Bump allocator for transient memory, see ImGui::MemAllocFrame(). Allocations are not freed individually but all at once by Reset().
+// - When the block is full, further allocations fallback to the heap until Reset(), which then grows the block to the peak usage.
+//   After a few frames, steady state doesn't touch the heap.
+// - Allocations >= IM_LINEAR_ALLOCATOR_LARGE_ALLOC (e.g. a big clipboard paste) always go to the heap and don't grow the block.
+// - The block shrinks back when usage stays under 1/4 of its size for IM_LINEAR_ALLOCATOR_SHRINK_FRAMES consecutive frames.
+// - Pointers are stable until Reset().
+#define IM_LINEAR_ALLOCATOR_LARGE_ALLOC     (64 * 1024)
+#define IM_LINEAR_ALLOCATOR_SHRINK_FRAMES   120
+struct IMGUI_API ImLinearAllocator
+{
+    char*           Block;          // Main block, reused across Reset()
+    size_t          BlockSize;
+    size_t          BlockUsed;
+    size_t          TotalUsed;      // Bytes requested since last Reset(), including overflow allocations but not large allocations
+    size_t          UnderusedPeak;  // Peak TotalUsed over the last UnderusedFrames frames
+    int             UnderusedFrames;// Number of consecutive frames with TotalUsed < BlockSize / 4
+    ImVector<void*> Overflow;       // Heap allocations done while the block was full or for large allocations, freed by Reset()
+
+    ImLinearAllocator()             { Block = NULL; BlockSize = BlockUsed = TotalUsed = UnderusedPeak = 0; UnderusedFrames = 0; }
+    ~ImLinearAllocator()            { Clear(); }
+    void*           Alloc(size_t size, size_t align = 16);
+    void            Reset();
+    void            Clear();
+};
+
 // Helper: ImPool<>
 // Basic keyed storage for contiguous instances, slow/amortized insertion, O(1) indexable, O(Log N) queries by ID over a dense/hot buffer,
 // Honor constructor/destructor. Add/remove invalidate all pointers. Indexes have the same lifetime as the associated object.
@@ -716,20 +916,6 @@ struct ImChunkStream
     void    swap(ImChunkStream<T>& rhs) { rhs.Buf.swap(Buf); }
 };
 
-// Helper: ImGuiTextIndex
-// Maintain a line index for a text buffer. This is a strong candidate to be moved into the public API.
-struct ImGuiTextIndex
-{
-    ImVector<int>   LineOffsets;
-    int             EndOffset = 0;                          // Because we don't own text buffer we need to maintain EndOffset (may bake in LineOffsets?)
-
-    void            clear()                                 { LineOffsets.clear(); EndOffset = 0; }
-    int             size()                                  { return LineOffsets.Size; }
-    const char*     get_line_begin(const char* base, int n) { return base + LineOffsets[n]; }
-    const char*     get_line_end(const char* base, int n)   { return base + (n + 1 < LineOffsets.Size ? (LineOffsets[n + 1] - 1) : EndOffset); }
-    void            append(const char* base, int old_size, int new_size);
-};
-
 // Helper: ImGuiStorage
 IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStoragePair* in_end, ImGuiID key);
 //-----------------------------------------------------------------------------
@@ -761,6 +947,31 @@ IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStorag
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// Word-wrapped text layout: one entry per visual line, offsets relative to start of text.
+struct ImFontWrapLine
+{
+    int             Begin;                      // Offset of first character (leading blanks after a wrap point have been skipped)
+    int             End;                        // Offset of wrap point, '\n' or end of text
+    float           Width;                      // Width of [Begin, End), same value as CalcTextSizeA() would compute
+};
+
+// Word-wrapped text layout, computed in a single pass by ImFontCalcWrapLayout().
+// ImDrawListSharedData holds the last one computed by ImGui::CalcTextSize() so that ImFont::RenderText() can reuse it for the same text.
+// - The key doesn't include the text contents: CalcTextSize() always refreshes the cache, so only modifying the text in-place between
+//   CalcTextSize() and RenderText() would reuse a stale layout. Line offsets never exceed the length so this can only affect wrapping.
+struct ImFontWrapLayout
+{
+    ImVector<ImFontWrapLine> Lines;
+    ImVec2          Size;                       // Same value as ImFont::CalcTextSizeA() with max_width == FLT_MAX
+    const ImFont*   Font;                       // Key: font, size, wrap width, text pointer and length
+    float           FontSize;
+    float           WrapWidth;
+    const char*     Text;
+    int             TextLen;
+
+    void            clear()                     { Lines.resize(0); Font = NULL; Text = NULL; }
+};
+
 // Data shared between all ImDrawList instances
 // You may want to create your own instance of this if you want to use ImDrawList completely without ImGui. In that case, watch out for future changes to this structure.
 struct IMGUI_API ImDrawListSharedData
@@ -783,6 +994,9 @@ struct IMGUI_API ImDrawListSharedData
     ImU8            CircleSegmentCounts[64];    // Precomputed segment count for given radius before we calculate it dynamically (to avoid calculation overhead)
     const ImVec4*   TexUvLines;                 // UV of anti-aliased lines in the atlas
 
+    // [Internal] Last word-wrapped layout computed by ImGui::CalcTextSize(), reused by ImFont::RenderText(). Cleared every frame.
+    ImFontWrapLayout WrapLayoutCache;
+
     ImDrawListSharedData();
     void SetCircleTessellationMaxError(float max_error);
 };
@@ -1053,6 +1267,16 @@ struct IMGUI_API ImGuiComboPreviewData
     ImGuiComboPreviewData() { memset(this, 0, sizeof(*this)); }
 };
 
+// Scratch buffer for the Combo() "item1\0item2\0" helper: offset of each item, rebuilt every frame its popup is open.
+// Nothing is reused across frames (the buffer may have been rebuilt in place), this only avoids reallocating the vector.
+struct IMGUI_API ImGuiComboItemsScratch
+{
+    const char*     Source;
+    ImVector<int>   Offsets;
+
+    ImGuiComboItemsScratch() { Source = NULL; }
+};
+
 // Stacked storage data for BeginGroup()/EndGroup()
 struct IMGUI_API ImGuiGroupData
 {
@@ -1099,14 +1323,74 @@ struct IMGUI_API ImGuiInputTextDeactivatedState
     void    ClearFreeMemory()           { ID = 0; TextA.clear(); }
 };
 
+// Line start offsets of a multi-line InputText() buffer, updated incrementally from the stb_textedit insert/delete callbacks.
+// Stored as a gap buffer split at the last edited line: offsets before the gap are absolute, offsets after the gap are stored
+// relative to the end of text, so successive edits around the same place don't need to touch the rest of the index.
+// Also caches the width of each line: lines touched by an edit are marked dirty (-1.0f) and measured again on next use.
+struct IMGUI_API ImGuiInputTextLineIndex
+{
+    ImVector<int>       Offsets;        // [0..GapBegin): start offset of lines. [GapEnd..Size): 'TextLen - start offset' of following lines.
+    ImVector<float>     Widths;         // Width of lines, same layout as Offsets[]. -1.0f when not measured yet.
+    int                 GapBegin;
+    int                 GapEnd;
+    int                 TextLen;        // Length of indexed text, in bytes
+    ImFont*             WidthsFont;     // Font used to measure Widths[]
+    float               WidthsFontSize;
+    bool                Valid;          // Set to false when text is replaced as a whole, index is rebuilt on next use.
+
+    ImGuiInputTextLineIndex()           { memset(this, 0, sizeof(*this)); }
+    void    Clear()                     { Offsets.clear(); Widths.clear(); GapBegin = GapEnd = TextLen = 0; WidthsFont = NULL; Valid = false; }
+    int     GetLineCount() const        { return Offsets.Size - (GapEnd - GapBegin); }
+    int     GetLineSlot(int line_no) const  { IM_ASSERT(line_no >= 0 && line_no < GetLineCount()); return (line_no < GapBegin) ? line_no : line_no + GapEnd - GapBegin; }
+    int     GetLineStart(int line_no) const { return (line_no < GapBegin) ? Offsets.Data[GetLineSlot(line_no)] : TextLen - Offsets.Data[GetLineSlot(line_no)]; }
+    int     GetLineEnd(int line_no) const   { return (line_no + 1 < GetLineCount()) ? GetLineStart(line_no + 1) : TextLen; } // Including trailing '\n'
+    int     FindLine(int offset) const; // Return line containing byte offset, in O(log N)
+    void    Build(const char* text, int text_len);
+    void    MoveGap(int line_no);
+    void    OnInsertChars(int pos, const char* new_text, int new_text_len);
+    void    OnDeleteChars(int pos, int n);
+};
+
+// Undo/redo history of InputText(), used instead of the fixed-size arrays of stb_textedit.h (see IMSTB_TEXTEDIT_UNDO_EXTERNAL).
+// Each record replaces 'OldLen' bytes at 'Where' with 'NewLen' bytes and stores both texts, so undo and redo don't move record data around.
+// Records are appended at the back and discarded from the front when exceeding io.ConfigInputTextUndoMemoryMax. Discarded space is
+// reclaimed once it reaches half of the buffers, so they behave like growable ring buffers.
+// Consecutive typing/Backspace/Delete are coalesced into a single record, which is split at the start of each word.
+struct ImGuiInputTextUndoRecord
+{
+    int                 Where;          // Byte offset of edit
+    int                 OldLen;         // Bytes removed by edit, stored at Text[TextOffset]
+    int                 NewLen;         // Bytes inserted by edit, stored at Text[TextOffset + OldLen]
+    int                 TextOffset;     // Offset into ImGuiInputTextUndoStack::Text[]
+};
+
+struct IMGUI_API ImGuiInputTextUndoStack
+{
+    ImVector<ImGuiInputTextUndoRecord> Records;
+    ImVector<char>      Text;           // Old text followed by new text of each record
+    int                 RecordsBegin;   // Index of oldest record, records before it have been discarded
+    int                 UndoPoint;      // Records[RecordsBegin..UndoPoint) can be undone, Records[UndoPoint..Size) can be redone
+    bool                Typing;         // Set by caller while processing typed characters, Backspace or Delete: record may be coalesced with last one
+    bool                LastTyping;     // Last record was created while typing and may be extended
+
+    ImGuiInputTextUndoStack()           { memset(this, 0, sizeof(*this)); }
+    void    Clear()                     { Records.resize(0); Text.resize(0); RecordsBegin = UndoPoint = 0; LastTyping = false; }
+    void    ClearFreeMemory()           { Records.clear(); Text.clear(); RecordsBegin = UndoPoint = 0; LastTyping = false; }
+    int     GetUndoCount() const        { return UndoPoint - RecordsBegin; }
+    int     GetRedoCount() const        { return Records.Size - UndoPoint; }
+    int     GetMemoryUsage() const      { return (Records.Size - RecordsBegin) * (int)sizeof(ImGuiInputTextUndoRecord) + Text.Size - (RecordsBegin < Records.Size ? Records[RecordsBegin].TextOffset : Text.Size); }
+    void    AddRecord(int where, const char* old_text, int old_len, const char* new_text, int new_len, int memory_max);
+    bool    MergeRecord(int where, const char* old_text, int old_len, const char* new_text, int new_len);
+    void    DiscardOldest(int memory_max);
+};
+
 // Forward declare imstb_textedit.h structure + make its main configuration define accessible
 #undef IMSTB_TEXTEDIT_STRING
 #undef IMSTB_TEXTEDIT_CHARTYPE
 #define IMSTB_TEXTEDIT_STRING             ImGuiInputTextState
 #define IMSTB_TEXTEDIT_CHARTYPE           char
 #define IMSTB_TEXTEDIT_GETWIDTH_NEWLINE   (-1.0f)
-#define IMSTB_TEXTEDIT_UNDOSTATECOUNT     99
-#define IMSTB_TEXTEDIT_UNDOCHARCOUNT      999
+#define IMSTB_TEXTEDIT_UNDO_EXTERNAL                              // Undo/redo history is stored in ImGuiInputTextState::UndoStack
 namespace ImStb { struct STB_TexteditState; }
 typedef ImStb::STB_TexteditState ImStbTexteditState;
 
@@ -1120,13 +1404,17 @@ struct IMGUI_API ImGuiInputTextState
     int                     CurLenA;                // UTF-8 length of the string in TextA (in bytes)
     ImVector<char>          TextA;                  // main UTF8 buffer.
     ImVector<char>          InitialTextA;           // value to revert to when pressing Escape = backup of end-user buffer at the time of focus (in UTF-8, unaltered)
-    ImVector<char>          CallbackTextBackup;     // temporary storage for callback to support automatic reconcile of undo-stack
+    ImVector<char>          CallbackTextBackup;     // copy of TextA for callback to support automatic reconcile of undo-stack
+    bool                    CallbackTextBackupValid;// CallbackTextBackup[] matches TextA, cleared on edit
+    ImGuiInputTextLineIndex LineIndex;              // line start offsets into TextA (multi-line only, built on first use)
+    ImGuiInputTextUndoStack UndoStack;              // undo/redo history
     int                     BufCapacityA;           // end-user buffer capacity
     ImVec2                  Scroll;                 // horizontal offset (managed manually) + vertical scrolling (pulled from child window's own Scroll.y)
     float                   CursorAnim;             // timer for cursor blink, reset on every user action so the cursor reappears immediately
     bool                    CursorFollow;           // set when we want scrolling to follow the current cursor position (not always!)
     bool                    SelectedAllMouseLock;   // after a double-click to select all, we ignore further mouse drags to update selection
     bool                    Edited;                 // edited this frame
+    bool                    UserBufDirty;           // edited since TextA was last applied to user buffer
     ImGuiInputTextFlags     Flags;                  // copy of InputText() flags. may be used to check if e.g. ImGuiInputTextFlags_Password is set.
     bool                    ReloadUserBuf;          // force a reload of user buf so it may be modified externally. may be automatic in future version.
     int                     ReloadSelectionStart;   // POSITIONS ARE IN IMWCHAR units *NOT* UTF-8 this is why this is not exposed yet.
@@ -1134,8 +1422,8 @@ struct IMGUI_API ImGuiInputTextState
 
     ImGuiInputTextState();
     ~ImGuiInputTextState();
-    void        ClearText()                 { CurLenA = 0; TextA[0] = 0; CursorClamp(); }
-    void        ClearFreeMemory()           { TextA.clear(); InitialTextA.clear(); }
+    void        ClearText()                 { CurLenA = 0; TextA[0] = 0; LineIndex.Valid = false; CallbackTextBackupValid = false; UndoStack.Clear(); CursorClamp(); }
+    void        ClearFreeMemory()           { TextA.clear(); InitialTextA.clear(); CallbackTextBackup.clear(); CallbackTextBackupValid = false; LineIndex.Clear(); UndoStack.ClearFreeMemory(); }
     void        OnKeyPressed(int key);      // Cannot be inline because we call in code in stb_textedit.h implementation
     void        OnCharPressed(unsigned int c);
 
@@ -1423,6 +1711,20 @@ struct ImGuiInputEvent
     ImGuiInputEvent() { memset(this, 0, sizeof(*this)); }
 };
 
+// Bounded lock-free multi-producer single-consumer queue for io.AddXXXEventThreadSafe() functions.
+// Each cell carries a sequence number telling whether it is free for position 'pos' (== pos) or holds the event for 'pos' (== pos + 1).
+// Producers reserve a position by incrementing EnqueuePos with a compare-and-swap, NewFrame() drains events into InputEventsQueue.
+struct ImGuiInputEventThreadSafeQueue
+{
+    struct Cell { ImU32 Sequence; ImGuiInputEvent Event; };
+    Cell*                           Cells;
+    ImU32                           Mask;           // Capacity - 1 (capacity is a power of two)
+    ImU32                           EnqueuePos;     // Shared by producers, only accessed atomically
+    ImU32                           DequeuePos;     // Only accessed by consumer (main thread)
+
+    ImGuiInputEventThreadSafeQueue() { memset(this, 0, sizeof(*this)); }
+};
+
 // Input function taking an 'ImGuiID owner_id' argument defaults to (ImGuiKeyOwner_Any == 0) aka don't test ownership, which matches legacy behavior.
 #define ImGuiKeyOwner_Any           ((ImGuiID)0)    // Accept key that have an owner, UNLESS a call to SetKeyOwner() explicitly used ImGuiInputFlags_LockThisFrame or ImGuiInputFlags_LockUntilRelease.
 #define ImGuiKeyOwner_NoOwner       ((ImGuiID)-1)   // Require key to have no owner.
@@ -1533,10 +1835,12 @@ struct ImGuiListClipperData
     float                           LossynessOffset;
     int                             StepNo;
     int                             ItemsFrozen;
+    int                             MeasureItem;            // Variable heights: item displayed by previous step, to measure on next step (-1 if none)
+    float                           MeasureStartPosY;       // Variable heights: cursor position before that item
     ImVector<ImGuiListClipperRange> Ranges;
 
     ImGuiListClipperData()          { memset(this, 0, sizeof(*this)); }
-    void                            Reset(ImGuiListClipper* clipper) { ListClipper = clipper; StepNo = ItemsFrozen = 0; Ranges.resize(0); }
+    void                            Reset(ImGuiListClipper* clipper) { ListClipper = clipper; StepNo = ItemsFrozen = 0; MeasureItem = -1; Ranges.resize(0); }
 };
 
 //-----------------------------------------------------------------------------
@@ -2044,6 +2348,10 @@ struct ImGuiSettingsHandler
     void        (*ApplyAllFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler);                                // Read: Called after reading (in registration order)
     void        (*WriteAllFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* out_buf);      // Write: Output every entries into 'out_buf'
     void*       UserData;
+    bool        WriteCacheAllowed;  // Set if every change to this handler's data is signaled with MarkIniSettingsDirty(): SaveIniSettingsToMemory() may then reuse the previous output of WriteAllFn() instead of calling it again.
+    bool        WriteCacheValid;    // [Internal] Previous output is still up to date (cleared by MarkIniSettingsDirty())
+    int         WriteCacheOffset;   // [Internal] Previous output location in g.SettingsIniDataPrev
+    int         WriteCacheSize;     // [Internal]
 
     ImGuiSettingsHandler() { memset(this, 0, sizeof(*this)); }
 };
@@ -2232,6 +2540,7 @@ struct ImGuiContext
     ImVector<ImGuiInputEvent> InputEventsTrail;                 // Past input events processed in NewFrame(). This is to allow domain-specific application to access e.g mouse/pen trail.
     ImGuiMouseSource        InputEventsNextMouseSource;
     ImU32                   InputEventsNextEventId;
+    ImGuiInputEventThreadSafeQueue InputEventsThreadSafeQueue;  // Events submitted by io.AddXXXThreadSafe() functions, forwarded to InputEventsQueue by NewFrame()
 
     // Windows state
     ImVector<ImGuiWindow*>  Windows;                            // Windows, sorted in display order, back to front
@@ -2317,8 +2626,8 @@ struct ImGuiContext
     ImVector<ImGuiStyleMod>         StyleVarStack;              // Stack for PushStyleVar()/PopStyleVar() - inherited by Begin()
     ImVector<ImFont*>               FontStack;                  // Stack for PushFont()/PopFont() - inherited by Begin()
     ImVector<ImGuiFocusScopeData>   FocusScopeStack;            // Stack for PushFocusScope()/PopFocusScope() - inherited by BeginChild(), pushed into by Begin()
-    ImVector<ImGuiItemFlags>        ItemFlagsStack;             // Stack for PushItemFlag()/PopItemFlag() - inherited by Begin()
-    ImVector<ImGuiGroupData>        GroupStack;                 // Stack for BeginGroup()/EndGroup() - not inherited by Begin()
+    ImVectorInline<ImGuiItemFlags, 8> ItemFlagsStack;           // Stack for PushItemFlag()/PopItemFlag() - inherited by Begin()
+    ImVectorInline<ImGuiGroupData, 4> GroupStack;               // Stack for BeginGroup()/EndGroup() - not inherited by Begin()
     ImVector<ImGuiPopupData>        OpenPopupStack;             // Which popups are open (persistent)
     ImVector<ImGuiPopupData>        BeginPopupStack;            // Which level of BeginPopup() we are in (reset every frame)
     ImVector<ImGuiTreeNodeStackData>TreeNodeStack;              // Stack for TreeNode()
@@ -2482,6 +2791,7 @@ struct ImGuiContext
     ImU32                   ColorEditSavedColor;                // RGB value with alpha set to 0.
     ImVec4                  ColorPickerRef;                     // Initial/reference color at the time of opening the color picker.
     ImGuiComboPreviewData   ComboPreviewData;
+    ImGuiComboItemsScratch  ComboItemsScratch;
     ImRect                  WindowResizeBorderExpectedRect;     // Expected border rect, switch to relative edit if moving
     bool                    WindowResizeRelativeMode;
     short                   ScrollbarSeekMode;                  // 0: scroll to clicked location, -1/+1: prev/next page.
@@ -2514,6 +2824,7 @@ struct ImGuiContext
     bool                    SettingsLoaded;
     float                   SettingsDirtyTimer;                 // Save .ini Settings to memory when time reaches zero
     ImGuiTextBuffer         SettingsIniData;                    // In memory .ini settings
+    ImGuiTextBuffer         SettingsIniDataPrev;                // Previous output of SaveIniSettingsToMemory(), handlers with a valid write cache are copied from there
     ImVector<ImGuiSettingsHandler>      SettingsHandlers;       // List of .ini settings handlers
     ImChunkStream<ImGuiWindowSettings>  SettingsWindows;        // ImGuiWindow .ini settings entries
     ImChunkStream<ImGuiTableSettings>   SettingsTables;         // ImGuiTable .ini settings entries
@@ -2577,6 +2888,7 @@ struct ImGuiContext
     int                     WantCaptureKeyboardNextFrame;       // "
     int                     WantTextInputNextFrame;
     ImVector<char>          TempBuffer;                         // Temporary text buffer
+    ImLinearAllocator       FrameArena;                         // Transient memory, reset by NewFrame(). See MemAllocFrame().
     char                    TempKeychordName[64];
 
     ImGuiContext(ImFontAtlas* shared_font_atlas);
@@ -2710,7 +3022,7 @@ struct IMGUI_API ImGuiWindow
     ImVec2                  SetWindowPosVal;                    // store window position when using a non-zero Pivot (position set needs to be processed when we know the window size)
     ImVec2                  SetWindowPosPivot;                  // store window pivot for positioning. ImVec2(0, 0) when positioning from top-left corner; ImVec2(0.5f, 0.5f) for centering; ImVec2(1, 1) for bottom right.
 
-    ImVector<ImGuiID>       IDStack;                            // ID stack. ID are hashes seeded with the value at the top of the stack. (In theory this should be in the TempData structure)
+    ImVectorInline<ImGuiID, 8> IDStack;                         // ID stack. ID are hashes seeded with the value at the top of the stack. (In theory this should be in the TempData structure)
     ImGuiWindowTempData     DC;                                 // Temporary per-window data, reset at the beginning of the frame. This used to be called ImGuiDrawContext, hence the "DC" variable name.
 
     // The best way to understand what those rectangles are is to use the 'Metrics->Tools->Show Windows Rectangles' viewer.
@@ -2987,6 +3299,7 @@ struct IMGUI_API ImGuiTable
     ImBitArrayPtr               EnabledMaskByDisplayOrder;  // Column DisplayOrder -> IsEnabled map
     ImBitArrayPtr               EnabledMaskByIndex;         // Column Index -> IsEnabled map (== not hidden by user/api) in a format adequate for iterating column without touching cold data
     ImBitArrayPtr               VisibleMaskByIndex;         // Column Index -> IsVisibleX|IsVisibleY map (== not hidden by user/api && not hidden by scrolling/cliprect)
+    ImBitArrayPtr               RequestOutputMaskByIndex;   // Column Index -> IsRequestOutput map (== visible, or needs contents for auto-fitting). Used by TableNextVisibleColumn() to skip over other columns.
     ImGuiTableFlags             SettingsLoadedFlags;        // Which data were loaded from the .ini file (e.g. when order is not altered we won't save order)
     int                         SettingsOffset;             // Offset in g.SettingsTables
     int                         LastFrameActive;
@@ -3042,6 +3355,8 @@ struct IMGUI_API ImGuiTable
     ImGuiTableColumnSortSpecs   SortSpecsSingle;
     ImVector<ImGuiTableColumnSortSpecs> SortSpecsMulti;     // FIXME-OPT: Using a small-vector pattern would be good.
     ImGuiTableSortSpecs         SortSpecs;                  // Public facing sorts specs, this is what we return in TableGetSortSpecs()
+    ImVector<ImGuiTableColumnSortSpecs> SortItemsSpecs;     // Sort specs used by last TableSortItems() call, to detect when only directions were flipped
+    int                         SortItemsCount;             // Items count of last TableSortItems() call (-1 if none)
     ImGuiTableColumnIdx         SortSpecsCount;
     ImGuiTableColumnIdx         ColumnsEnabledCount;        // Number of enabled columns (<= ColumnsCount)
     ImGuiTableColumnIdx         ColumnsEnabledFixedCount;   // Number of enabled columns using fixed width (<= ColumnsCount)
@@ -3090,7 +3405,7 @@ struct IMGUI_API ImGuiTable
     bool                        MemoryCompacted;
     bool                        HostSkipItems;              // Backup of InnerWindow->SkipItem at the end of BeginTable(), because we will overwrite InnerWindow->SkipItem on a per-column basis
 
-    ImGuiTable()                { memset(this, 0, sizeof(*this)); LastFrameActive = -1; }
+    ImGuiTable()                { memset(this, 0, sizeof(*this)); LastFrameActive = -1; SortItemsCount = -1; }
     ~ImGuiTable()               { IM_FREE(RawData); }
 };
 
@@ -3243,6 +3558,7 @@ namespace ImGui
     // Settings
     IMGUI_API void                  MarkIniSettingsDirty();
     IMGUI_API void                  MarkIniSettingsDirty(ImGuiWindow* window);
+    IMGUI_API void                  MarkIniSettingsDirty(ImGuiSettingsHandler* handler);
     IMGUI_API void                  ClearIniSettings();
     IMGUI_API void                  AddSettingsHandler(const ImGuiSettingsHandler* handler);
     IMGUI_API void                  RemoveSettingsHandler(const char* type_name);
@@ -3667,7 +3983,7 @@ namespace ImGui
     IMGUI_API ImDrawFlags   CalcRoundingFlagsForRectInRect(const ImRect& r_in, const ImRect& r_outer, float threshold);
 
     // Widgets
-    IMGUI_API void          TextEx(const char* text, const char* text_end = NULL, ImGuiTextFlags flags = 0);
+    IMGUI_API void          TextEx(const char* text, const char* text_end = NULL, ImGuiTextFlags flags = 0, ImGuiTextIndex* line_index = NULL); // Pass a persistent line_index for large append-only text, see ImGuiTextIndex. Also see public TextUnformatted(text, text_end, line_index).
     IMGUI_API bool          ButtonEx(const char* label, const ImVec2& size_arg = ImVec2(0, 0), ImGuiButtonFlags flags = 0);
     IMGUI_API bool          ArrowButtonEx(const char* str_id, ImGuiDir dir, ImVec2 size_arg, ImGuiButtonFlags flags = 0);
     IMGUI_API bool          ImageButtonEx(ImGuiID id, ImTextureID texture_id, const ImVec2& image_size, const ImVec2& uv0, const ImVec2& uv1, const ImVec4& bg_col, const ImVec4& tint_col, ImGuiButtonFlags flags = 0);
@@ -3740,6 +4056,11 @@ namespace ImGui
     IMGUI_API void          ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp);
     IMGUI_API void          ShadeVertsTransformPos(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& pivot_in, float cos_a, float sin_a, const ImVec2& pivot_out);
 
+    // Transient memory
+    // - Allocated from a per-context arena (g.FrameArena) which is reset by NewFrame(). Valid until then, don't free it.
+    // - Cheap scratch memory for widgets: no heap traffic in steady state, and large/unusual sizes are handled gracefully.
+    IMGUI_API void*         MemAllocFrame(size_t size, size_t align = 16);
+
     // Garbage collection
     IMGUI_API void          GcCompactTransientMiscBuffers();
     IMGUI_API void          GcCompactTransientWindowBuffers(ImGuiWindow* window);
@@ -3812,6 +4133,10 @@ namespace ImGui
 // [SECTION] ImFontAtlas internal API
 //-----------------------------------------------------------------------------
 
+// Virtual texture height used while packing, and height above which ImFontAtlasBuildCalcTexWidth() will prefer a wider texture.
+#define IM_FONTATLAS_TEX_HEIGHT_MAX             (1024 * 32)
+#define IM_FONTATLAS_TEX_HEIGHT_PREFERRED_MAX   (1024 * 8)
+
 // This structure is likely to evolve as we add support for incremental atlas updates
 struct ImFontBuilderIO
 {
@@ -3825,13 +4150,20 @@ IMGUI_API const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype();
 IMGUI_API void      ImFontAtlasUpdateConfigDataPointers(ImFontAtlas* atlas);
 IMGUI_API void      ImFontAtlasBuildInit(ImFontAtlas* atlas);
 IMGUI_API void      ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent);
+IMGUI_API int       ImFontAtlasBuildCalcTexWidth(ImFontAtlas* atlas, const void* stbrp_glyph_rects_opaque, int glyph_rects_count, int total_surface);
 IMGUI_API void      ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opaque);
+IMGUI_API void      ImFontAtlasBuildPackGlyphRects(ImFontAtlas* atlas, void* stbrp_context_opaque, void* stbrp_glyph_rects_opaque, int glyph_rects_count);
 IMGUI_API void      ImFontAtlasBuildFinish(ImFontAtlas* atlas);
 IMGUI_API void      ImFontAtlasBuildRender8bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned char in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned int in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
 
+// Word-wrapped text layout helpers (single pass over text, see ImFont::CalcWordWrapLineEndA())
+IMGUI_API ImVec2    ImFontCalcWrapLayout(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end, ImVector<ImFontWrapLine>* out_lines);
+IMGUI_API const ImFontWrapLayout* ImFontFindWrapLayout(const ImFontWrapLayout* cache, const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end);
+IMGUI_API const ImFontWrapLayout* ImFontUpdateWrapLayout(ImFontWrapLayout* cache, const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end);
+
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
 //-----------------------------------------------------------------------------
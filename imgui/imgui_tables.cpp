@@ -60,6 +60,7 @@ Index of this file:
 //    | TableEndRow()                           - finish existing row
 //    | TableBeginRow()                         - add a new row
 // - TableSetColumnIndex() / TableNextColumn()  user begin into a cell
+//   or TableNextVisibleColumn()                user begin into a cell, skipping clipped columns
 //    | TableEndCell()                          - close existing column/cell
 //    | TableBeginCell()                        - enter into current column/cell
 // - [...]                                      user emit contents
@@ -641,11 +642,11 @@ void ImGui::TableBeginInitMemory(ImGuiTable* table, int columns_count)
 {
     // Allocate single buffer for our arrays
     const int columns_bit_array_size = (int)ImBitArrayGetStorageSizeInBytes(columns_count);
-    ImSpanAllocator<6> span_allocator;
+    ImSpanAllocator<7> span_allocator;
     span_allocator.Reserve(0, columns_count * sizeof(ImGuiTableColumn));
     span_allocator.Reserve(1, columns_count * sizeof(ImGuiTableColumnIdx));
     span_allocator.Reserve(2, columns_count * sizeof(ImGuiTableCellData), 4);
-    for (int n = 3; n < 6; n++)
+    for (int n = 3; n < 7; n++)
         span_allocator.Reserve(n, columns_bit_array_size);
     table->RawData = IM_ALLOC(span_allocator.GetArenaSizeInBytes());
     memset(table->RawData, 0, span_allocator.GetArenaSizeInBytes());
@@ -656,6 +657,7 @@ void ImGui::TableBeginInitMemory(ImGuiTable* table, int columns_count)
     table->EnabledMaskByDisplayOrder = (ImU32*)span_allocator.GetSpanPtrBegin(3);
     table->EnabledMaskByIndex = (ImU32*)span_allocator.GetSpanPtrBegin(4);
     table->VisibleMaskByIndex = (ImU32*)span_allocator.GetSpanPtrBegin(5);
+    table->RequestOutputMaskByIndex = (ImU32*)span_allocator.GetSpanPtrBegin(6);
 }
 
 // Apply queued resizing/reordering/hiding requests
@@ -1039,6 +1041,7 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
     ImRect host_clip_rect = table->InnerClipRect;
     //host_clip_rect.Max.x += table->CellPaddingX + table->CellSpacingX2;
     ImBitArrayClearAllBits(table->VisibleMaskByIndex, table->ColumnsCount);
+    ImBitArrayClearAllBits(table->RequestOutputMaskByIndex, table->ColumnsCount);
     for (int order_n = 0; order_n < table->ColumnsCount; order_n++)
     {
         const int column_n = table->DisplayOrderToIndex[order_n];
@@ -1109,6 +1112,8 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
 
         // Mark column as requesting output from user. Note that fixed + non-resizable sets are auto-fitting at all times and therefore always request output.
         column->IsRequestOutput = is_visible || column->AutoFitQueue != 0 || column->CannotSkipItemsQueue != 0;
+        if (column->IsRequestOutput)
+            ImBitArraySetBit(table->RequestOutputMaskByIndex, column_n);
 
         // Mark column as SkipItems (ignoring all items/layout)
         // (table->HostSkipItems is a copy of inner_window->SkipItems before we cleared it above in Part 2)
@@ -1178,6 +1183,7 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
     if (has_at_least_one_column_requesting_output == false)
     {
         table->Columns[table->LeftMostEnabledColumn].IsRequestOutput = true;
+        ImBitArraySetBit(table->RequestOutputMaskByIndex, table->LeftMostEnabledColumn);
         table->Columns[table->LeftMostEnabledColumn].IsSkipItems = false;
     }
 
@@ -2054,6 +2060,7 @@ void ImGui::TableEndRow(ImGuiTable* table)
 // - TableGetColumnIndex()
 // - TableSetColumnIndex()
 // - TableNextColumn()
+// - TableNextVisibleColumn()
 // - TableBeginCell() [Internal]
 // - TableEndCell() [Internal]
 //-------------------------------------------------------------------------
@@ -2113,6 +2120,46 @@ bool ImGui::TableNextColumn()
     return table->Columns[table->CurrentColumn].IsRequestOutput;
 }
 
+// [Public] Append into the next visible column of current row, skipping columns which are clipped or hidden.
+// - Unlike TableNextColumn(), skipped cells are not entered at all, so their cost is zero. Use for very wide tables.
+// - Unlike TableNextColumn(), this doesn't wrap-around into a new row: it returns false when reaching the end of current row.
+// - Skipped columns won't contribute to row height: use TableNextColumn()/TableSetColumnIndex() for those which may be taller.
+// Typical usage:
+//   TableNextRow();
+//   while (TableNextVisibleColumn())
+//       Text("Cell %d,%d", row_n, TableGetColumnIndex());
+bool ImGui::TableNextVisibleColumn()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTable* table = g.CurrentTable;
+    if (!table)
+        return false;
+    IM_ASSERT(table->IsInsideRow && "Need to call TableNextRow() before TableNextVisibleColumn()!");
+
+    // Find next set bit in RequestOutputMaskByIndex[], skipping 32 columns at a time when possible
+    const ImU32* mask = table->RequestOutputMaskByIndex;
+    int column_n = table->CurrentColumn + 1;
+    while (column_n < table->ColumnsCount)
+    {
+        const ImU32 bits = mask[column_n >> 5] >> (column_n & 31);
+        if (bits == 0)
+        {
+            column_n = (column_n | 31) + 1;
+            continue;
+        }
+        if (bits & 1)
+            break;
+        column_n++;
+    }
+    if (column_n >= table->ColumnsCount)
+        return false;
+
+    if (table->CurrentColumn != -1)
+        TableEndCell(table);
+    TableBeginCell(table, column_n);
+    return true;
+}
+
 
 // [Internal] Called by TableSetColumnIndex()/TableNextColumn()
 // This is called very frequently, so we need to be mindful of unnecessary overhead.
@@ -2790,6 +2837,7 @@ void ImGui::TableDrawBorders(ImGuiTable* table)
 // - TableSetColumnSortDirection() [Internal]
 // - TableSortSpecsSanitize() [Internal]
 // - TableSortSpecsBuild() [Internal]
+// - TableSortItems()
 //-------------------------------------------------------------------------
 
 // Return NULL if no sort specs (most often when ImGuiTableFlags_Sortable is not set)
@@ -2978,6 +3026,230 @@ void ImGui::TableSortSpecsBuild(ImGuiTable* table)
     table->SortSpecs.SpecsCount = table->SortSpecsCount;
 }
 
+// Data for TableSortItems()
+// - Keys are extracted once into Keys[spec_n * ItemsCount + item_idx]: comparing items doesn't call user code.
+// - We perform one stable sort pass per sorted column, starting from the last one (so ties on a column keep the order of the next one).
+//   Each pass sorts (key, index) pairs where 'key' is a double: the number itself, or the first bytes of a string, with direction applied.
+//   Only ties on string prefixes (or columns mixing strings and numbers) need to look up Keys[].
+struct ImGuiTableSortItemsContext
+{
+    const ImGuiTableColumnSortSpecs*    Specs;
+    int                                 SpecsCount;
+    int                                 ItemsCount;
+    const ImGuiTableSortKey*            Keys;
+    const ImGuiTableSortKey*            PassKeys;           // Keys of column sorted by current pass
+    bool                                PassDescending;
+    bool                                PassCompareKeysOnTies;
+};
+
+struct ImGuiTableSortItem
+{
+    double      Key;
+    ImU32       Index;
+};
+
+static int TableSortItems_CompareKey(const ImGuiTableSortKey* a, const ImGuiTableSortKey* b)
+{
+    if (a->String != NULL && b->String != NULL)
+        return strcmp(a->String, b->String);
+    if (a->String != NULL || b->String != NULL)
+        return (a->String != NULL) ? +1 : -1;
+    return (a->Number < b->Number) ? -1 : (a->Number > b->Number) ? +1 : 0;
+}
+
+// Compare two items on all sorted columns (not using their index)
+static int TableSortItems_CompareItems(const ImGuiTableSortItemsContext* ctx, ImU32 a, ImU32 b)
+{
+    for (int spec_n = 0; spec_n < ctx->SpecsCount; spec_n++)
+    {
+        const ImGuiTableSortKey* keys = ctx->Keys + (size_t)spec_n * ctx->ItemsCount;
+        if (int d = TableSortItems_CompareKey(&keys[a], &keys[b]))
+            return (ctx->Specs[spec_n].SortDirection == ImGuiSortDirection_Descending) ? -d : d;
+    }
+    return 0;
+}
+
+// First 6 bytes of a string as a number (exactly representable by a double), preserving strcmp() order when different
+static double TableSortItems_StringPrefixKey(const char* s)
+{
+    ImU64 v = 0;
+    int n = 0;
+    for (; n < 6 && s[n] != 0; n++)
+        v = (v << 8) | (unsigned char)s[n];
+    return (double)(v << (8 * (6 - n)));
+}
+
+static inline bool TableSortItems_IsLess(const ImGuiTableSortItemsContext* ctx, const ImGuiTableSortItem& a, const ImGuiTableSortItem& b)
+{
+    if (a.Key != b.Key)
+        return a.Key < b.Key;
+    if (!ctx->PassCompareKeysOnTies)
+        return false;
+    const int d = TableSortItems_CompareKey(&ctx->PassKeys[a.Index], &ctx->PassKeys[b.Index]);
+    return ctx->PassDescending ? (d > 0) : (d < 0);
+}
+
+// Stable bottom-up merge sort: insertion sort small runs, then merge runs of doubling width between 'items' and 'temp'.
+static void TableSortItems_MergeSort(const ImGuiTableSortItemsContext* ctx, ImGuiTableSortItem* items, ImGuiTableSortItem* temp, int count)
+{
+    const int RUN_SIZE = 32;
+    for (int run_start = 0; run_start < count; run_start += RUN_SIZE)
+    {
+        const int run_end = ImMin(run_start + RUN_SIZE, count);
+        for (int i = run_start + 1; i < run_end; i++)
+        {
+            ImGuiTableSortItem item = items[i];
+            int j = i;
+            for (; j > run_start && TableSortItems_IsLess(ctx, item, items[j - 1]); j--)
+                items[j] = items[j - 1];
+            items[j] = item;
+        }
+    }
+
+    ImGuiTableSortItem* src = items;
+    ImGuiTableSortItem* dst = temp;
+    for (int width = RUN_SIZE; width < count; width *= 2)
+    {
+        for (int lo = 0; lo < count; lo += width * 2)
+        {
+            const int mid = ImMin(lo + width, count);
+            const int hi = ImMin(lo + width * 2, count);
+            if (mid == hi || !TableSortItems_IsLess(ctx, src[mid], src[mid - 1]))
+            {
+                // Already in order (common when re-sorting mostly sorted data)
+                memcpy(dst + lo, src + lo, (size_t)(hi - lo) * sizeof(ImGuiTableSortItem));
+                continue;
+            }
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi)
+                dst[k++] = TableSortItems_IsLess(ctx, src[j], src[i]) ? src[j++] : src[i++];
+            while (i < mid)
+                dst[k++] = src[i++];
+            while (j < hi)
+                dst[k++] = src[j++];
+        }
+        ImSwap(src, dst);
+    }
+    if (src != items)
+        memcpy(items, src, (size_t)count * sizeof(ImGuiTableSortItem));
+}
+
+// Sorting helper: output in indices[items_count] the indices of your items in sorted order, according to current table sort specs.
+// - Return true when 'indices' were updated: when sort specs are dirty or when items_count changed. Clears sort_specs->SpecsDirty.
+// - 'get_key' is called once per item and per sorted column. Sort is stable: items with identical keys are kept in the order of their index.
+// - When directions of all sorted columns are flipped (e.g. clicking the same column header again), previous 'indices' are reversed
+//   and verified in O(N) instead of being sorted again. If your items have changed since they were sorted, verification fails and we sort.
+bool ImGui::TableSortItems(ImU32* indices, int items_count, ImGuiTableSortKeyGetter get_key, void* user_data)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTable* table = g.CurrentTable;
+    IM_ASSERT(table != NULL && "Need to call TableSortItems() after BeginTable()!");
+    IM_ASSERT((indices != NULL || items_count == 0) && items_count >= 0 && get_key != NULL);
+
+    ImGuiTableSortSpecs* sort_specs = TableGetSortSpecs();
+    const bool indices_valid = (table->SortItemsCount == items_count);
+    if (indices_valid && (sort_specs == NULL || !sort_specs->SpecsDirty))
+        return false;
+    if (sort_specs != NULL)
+        sort_specs->SpecsDirty = false;
+    table->SortItemsCount = items_count;
+
+    // Not sorting: output items in their natural order
+    const int specs_count = sort_specs ? sort_specs->SpecsCount : 0;
+    const int prev_specs_count = table->SortItemsSpecs.Size;
+    table->SortItemsSpecs.resize(specs_count);
+    if (specs_count == 0 || items_count == 0)
+    {
+        for (int item_n = 0; item_n < items_count; item_n++)
+            indices[item_n] = (ImU32)item_n;
+        return true;
+    }
+
+    // Extract keys
+    ImVector<ImGuiTableSortKey> keys;
+    keys.resize(specs_count * items_count, ImGuiTableSortKey());
+    for (int spec_n = 0; spec_n < specs_count; spec_n++)
+    {
+        ImGuiTableSortKey* spec_keys = keys.Data + (size_t)spec_n * items_count;
+        for (int item_n = 0; item_n < items_count; item_n++)
+            get_key(user_data, item_n, &sort_specs->Specs[spec_n], &spec_keys[item_n]);
+    }
+    ImGuiTableSortItemsContext ctx;
+    ctx.Specs = sort_specs->Specs;
+    ctx.SpecsCount = specs_count;
+    ctx.ItemsCount = items_count;
+    ctx.Keys = keys.Data;
+    ctx.PassKeys = NULL;
+    ctx.PassDescending = ctx.PassCompareKeysOnTies = false;
+
+    // Only directions flipped: reverse previous order, then restore index order within each run of identical keys.
+    bool is_direction_flip = indices_valid && (prev_specs_count == specs_count);
+    for (int spec_n = 0; spec_n < specs_count && is_direction_flip; spec_n++)
+        if (table->SortItemsSpecs[spec_n].ColumnIndex != sort_specs->Specs[spec_n].ColumnIndex || table->SortItemsSpecs[spec_n].SortDirection == sort_specs->Specs[spec_n].SortDirection)
+            is_direction_flip = false;
+    for (int item_n = 0; item_n < items_count && is_direction_flip; item_n++)
+        if (indices[item_n] >= (ImU32)items_count)
+            is_direction_flip = false;
+    memcpy(table->SortItemsSpecs.Data, sort_specs->Specs, sizeof(ImGuiTableColumnSortSpecs) * specs_count);
+    if (is_direction_flip)
+    {
+        for (int i = 0, j = items_count - 1; i < j; i++, j--)
+            ImSwap(indices[i], indices[j]);
+        for (int run_start = 0; run_start < items_count; )
+        {
+            int run_end = run_start + 1;
+            while (run_end < items_count && TableSortItems_CompareItems(&ctx, indices[run_start], indices[run_end]) == 0)
+                run_end++;
+            for (int i = run_start, j = run_end - 1; i < j; i++, j--)
+                ImSwap(indices[i], indices[j]);
+            run_start = run_end;
+        }
+
+        // Verify that output is strictly ordered: this is the case unless items were modified since last sort.
+        // As (keys, index) is a total order, this also guarantees that 'indices' is the same permutation a full sort would output.
+        bool is_sorted = true;
+        for (int item_n = 1; item_n < items_count && is_sorted; item_n++)
+        {
+            const ImU32 a = indices[item_n - 1], b = indices[item_n];
+            const int d = TableSortItems_CompareItems(&ctx, a, b);
+            is_sorted = (d < 0) || (d == 0 && a < b);
+        }
+        if (is_sorted)
+            return true;
+    }
+
+    // Full sort: one pass per sorted column, starting from the last one
+    ImGuiTableSortItem* items = (ImGuiTableSortItem*)IM_ALLOC(sizeof(ImGuiTableSortItem) * (size_t)items_count * 2);
+    for (int item_n = 0; item_n < items_count; item_n++)
+        items[item_n].Index = (ImU32)item_n;
+    for (int spec_n = specs_count - 1; spec_n >= 0; spec_n--)
+    {
+        const ImGuiTableSortKey* spec_keys = keys.Data + (size_t)spec_n * items_count;
+        bool has_numbers = false, has_strings = false;
+        for (int item_n = 0; item_n < items_count && !(has_numbers && has_strings); item_n++)
+            (spec_keys[item_n].String != NULL ? has_strings : has_numbers) = true;
+
+        // Strings-only columns use their prefix as key, mixed columns put strings after numbers and compare Keys[] on ties
+        ctx.PassKeys = spec_keys;
+        ctx.PassDescending = (sort_specs->Specs[spec_n].SortDirection == ImGuiSortDirection_Descending);
+        ctx.PassCompareKeysOnTies = has_strings;
+        const double sign = ctx.PassDescending ? -1.0 : +1.0;
+        for (int item_n = 0; item_n < items_count; item_n++)
+        {
+            const ImGuiTableSortKey& key = spec_keys[items[item_n].Index];
+            if (key.String == NULL)
+                items[item_n].Key = key.Number * sign;
+            else
+                items[item_n].Key = (has_numbers ? HUGE_VAL : TableSortItems_StringPrefixKey(key.String)) * sign;
+        }
+        TableSortItems_MergeSort(&ctx, items, items + items_count, items_count);
+    }
+    for (int item_n = 0; item_n < items_count; item_n++)
+        indices[item_n] = items[item_n].Index;
+    IM_FREE(items);
+    return true;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Tables: Headers
 //-------------------------------------------------------------------------
@@ -3043,10 +3315,9 @@ void ImGui::TableHeadersRow()
         return;
 
     const int columns_count = TableGetColumnCount();
-    for (int column_n = 0; column_n < columns_count; column_n++)
+    while (TableNextVisibleColumn()) // Skip cells of clipped columns entirely (wide tables)
     {
-        if (!TableSetColumnIndex(column_n))
-            continue;
+        const int column_n = TableGetColumnIndex();
 
         // Push an id to allow empty/unnamed headers. This is also idiomatic as it ensure there is a consistent ID path to access columns (for e.g. automation)
         const char* name = (TableGetColumnFlags(column_n) & ImGuiTableColumnFlags_NoHeaderLabel) ? "" : TableGetColumnName(column_n);
@@ -3650,7 +3921,8 @@ void ImGui::TableSaveSettings(ImGuiTable* table)
     settings->SaveFlags &= table->Flags;
     settings->RefScale = save_ref_scale ? table->RefScale : 0.0f;
 
-    MarkIniSettingsDirty();
+    if (ImGuiSettingsHandler* handler = FindSettingsHandler("Table"))
+        MarkIniSettingsDirty(handler);
 }
 
 void ImGui::TableLoadSettings(ImGuiTable* table)
@@ -3835,6 +4107,7 @@ void ImGui::TableSettingsAddSettingsHandler()
     ini_handler.ReadLineFn = TableSettingsHandler_ReadLine;
     ini_handler.ApplyAllFn = TableSettingsHandler_ApplyAll;
     ini_handler.WriteAllFn = TableSettingsHandler_WriteAll;
+    ini_handler.WriteCacheAllowed = true;
     AddSettingsHandler(&ini_handler);
 }
 
@@ -3866,6 +4139,8 @@ void ImGui::TableGcCompactTransientBuffers(ImGuiTable* table)
     IM_ASSERT(table->MemoryCompacted == false);
     table->SortSpecs.Specs = NULL;
     table->SortSpecsMulti.clear();
+    table->SortItemsSpecs.clear();
+    table->SortItemsCount = -1;
     table->IsSortSpecsDirty = true; // FIXME: In theory shouldn't have to leak into user performing a sort on resume.
     table->ColumnsNames.clear();
     table->MemoryCompacted = true;
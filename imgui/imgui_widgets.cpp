@@ -46,6 +46,7 @@ Index of this file:
 
 // System includes
 #include <stdint.h>     // intptr_t
+#include <locale.h>     // localeconv
 
 //-------------------------------------------------------------------------
 // Warnings
@@ -149,7 +150,7 @@ static ImVec2   InputTextCalcTextSize(ImGuiContext* ctx, const char* text_begin,
 // - BulletTextV()
 //-------------------------------------------------------------------------
 
-void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
+void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags, ImGuiTextIndex* line_index)
 {
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
@@ -168,7 +169,52 @@ void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
     const ImVec2 text_pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
     const float wrap_pos_x = window->DC.TextWrapPos;
     const bool wrap_enabled = (wrap_pos_x >= 0.0f);
-    if (text_end - text <= 2000 || wrap_enabled)
+    if (line_index != NULL)
+    {
+        // Indexed text: the index is extended with new text, so we can directly locate visible lines instead of scanning from the start.
+        // - Lines have a fixed height so the first/last visible lines are found with a division (in visual lines when word-wrapping).
+        // - The text is expected to be append-only. Call line_index->clear() if it was modified in other ways.
+        const int text_len = (int)(text_end - text);
+        if (line_index->EndOffset > text_len)
+            line_index->clear();
+        line_index->append(text, line_index->EndOffset, text_len);
+
+        const float wrap_width = wrap_enabled ? CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x) : 0.0f;
+        const bool need_full_width = wrap_enabled || (flags & ImGuiTextFlags_NoWidthForLargeClippedText) == 0;
+        if (need_full_width)
+            line_index->layout(text, g.Font, g.FontSize, wrap_width);
+
+        const float line_height = GetTextLineHeight();
+        const int lines_count = wrap_enabled ? line_index->WrappedLineOffsets.Size : line_index->size();
+        int line_first = 0;
+        int line_last = lines_count;
+        if (!g.LogEnabled) // Can't skip when logging text
+        {
+            line_first = ImClamp((int)((window->ClipRect.Min.y - text_pos.y) / line_height), 0, lines_count);
+            line_last = ImClamp((int)ImCeil((window->ClipRect.Max.y - text_pos.y) / line_height), line_first, lines_count);
+        }
+
+        ImVec2 text_size(need_full_width ? line_index->MaxLineWidth : 0.0f, ImMax(lines_count, 1) * line_height); // Empty text is one line high, same as CalcTextSize()
+        if (line_first < line_last)
+        {
+            const int* line_offsets = wrap_enabled ? line_index->WrappedLineOffsets.Data : line_index->LineOffsets.Data;
+            const char* line_begin = text + line_offsets[line_first];
+            const char* line_end = (line_last < lines_count) ? text + line_offsets[line_last] : text_end;
+            const ImVec2 pos(text_pos.x, text_pos.y + line_first * line_height);
+            if (wrap_enabled)
+                RenderTextWrapped(pos, line_begin, line_end, wrap_width);
+            else
+                RenderText(pos, line_begin, line_end, false);
+            if (!need_full_width)
+                for (int line_n = line_first; line_n < line_last; line_n++)
+                    text_size.x = ImMax(text_size.x, CalcTextSize(line_index->get_line_begin(text, line_n), line_index->get_line_end(text, line_n)).x);
+        }
+
+        ImRect bb(text_pos, text_pos + text_size);
+        ItemSize(text_size, 0.0f);
+        ItemAdd(bb, 0);
+    }
+    else if (text_end - text <= 2000 || wrap_enabled)
     {
         // Common case
         const float wrap_width = wrap_enabled ? CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x) : 0.0f;
@@ -262,6 +308,11 @@ void ImGui::TextUnformatted(const char* text, const char* text_end)
     TextEx(text, text_end, ImGuiTextFlags_NoWidthForLargeClippedText);
 }
 
+void ImGui::TextUnformatted(const char* text, const char* text_end, ImGuiTextIndex* line_index)
+{
+    TextEx(text, text_end, ImGuiTextFlags_NoWidthForLargeClippedText, line_index);
+}
+
 void ImGui::Text(const char* fmt, ...)
 {
     va_list args;
@@ -1750,13 +1801,11 @@ bool ImGui::SplitterBehavior(const ImRect& bb, ImGuiID id, ImGuiAxis axis, float
     return held;
 }
 
-static int IMGUI_CDECL ShrinkWidthItemComparer(const void* lhs, const void* rhs)
+static int ShrinkWidthItemComparer(const ImGuiShrinkWidthItem& a, const ImGuiShrinkWidthItem& b)
 {
-    const ImGuiShrinkWidthItem* a = (const ImGuiShrinkWidthItem*)lhs;
-    const ImGuiShrinkWidthItem* b = (const ImGuiShrinkWidthItem*)rhs;
-    if (int d = (int)(b->Width - a->Width))
+    if (int d = (int)(b.Width - a.Width))
         return d;
-    return (b->Index - a->Index);
+    return (b.Index - a.Index);
 }
 
 // Shrink excess width from a set of item, by removing width from the larger items first.
@@ -1769,7 +1818,7 @@ void ImGui::ShrinkWidths(ImGuiShrinkWidthItem* items, int count, float width_exc
             items[0].Width = ImMax(items[0].Width - width_excess, 1.0f);
         return;
     }
-    ImQsort(items, (size_t)count, sizeof(ImGuiShrinkWidthItem), ShrinkWidthItemComparer);
+    ImSort<ImGuiShrinkWidthItem, ShrinkWidthItemComparer>(items, count);
     int count_same_width = 1;
     while (width_excess > 0.0f && count_same_width < count)
     {
@@ -1812,6 +1861,7 @@ void ImGui::ShrinkWidths(ImGuiShrinkWidthItem* items, int count, float width_exc
 // - BeginComboPreview() [Internal]
 // - EndComboPreview() [Internal]
 // - Combo()
+// - ComboItemsAndEnd() [Internal]
 //-------------------------------------------------------------------------
 
 static float CalcMaxPopupHeightFromItemCount(int items_count)
@@ -2048,6 +2098,18 @@ static const char* Items_SingleStringGetter(void* data, int idx)
     return *p ? p : NULL;
 }
 
+// Getter for the old Combo() API: "item1\0item2\0item3\0", using offsets computed this frame while the popup is open
+static const char* Items_SingleStringOffsetsGetter(void* data, int idx)
+{
+    const ImGuiComboItemsScratch* scratch = (const ImGuiComboItemsScratch*)data;
+    return scratch->Source + scratch->Offsets[idx];
+}
+
+namespace ImGui
+{
+    static bool             ComboItemsAndEnd(int* current_item, const char* (*getter)(void* user_data, int idx), void* user_data, int items_count);
+}
+
 // Old API, prefer using BeginCombo() nowadays if you can.
 bool ImGui::Combo(const char* label, int* current_item, const char* (*getter)(void* user_data, int idx), void* user_data, int items_count, int popup_max_height_in_items)
 {
@@ -2064,6 +2126,13 @@ bool ImGui::Combo(const char* label, int* current_item, const char* (*getter)(vo
 
     if (!BeginCombo(label, preview_value, ImGuiComboFlags_None))
         return false;
+    return ComboItemsAndEnd(current_item, getter, user_data, items_count);
+}
+
+// Display items of an open Combo() popup then call EndCombo()
+static bool ImGui::ComboItemsAndEnd(int* current_item, const char* (*getter)(void* user_data, int idx), void* user_data, int items_count)
+{
+    ImGuiContext& g = *GImGui;
 
     // Display items
     bool value_changed = false;
@@ -2104,17 +2173,24 @@ bool ImGui::Combo(const char* label, int* current_item, const char* const items[
 }
 
 // Combo box helper allowing to pass all items in a single string literal holding multiple zero-terminated items "item1\0item2\0"
+// While the popup is closed we only walk the string up to the current item to obtain the preview value.
+// While the popup is open, the offset of each item is computed once per frame so the clipper can access items directly.
 bool ImGui::Combo(const char* label, int* current_item, const char* items_separated_by_zeros, int height_in_items)
 {
-    int items_count = 0;
-    const char* p = items_separated_by_zeros;       // FIXME-OPT: Avoid computing this, or at least only when combo is open
-    while (*p)
-    {
-        p += strlen(p) + 1;
-        items_count++;
-    }
-    bool value_changed = Combo(label, current_item, Items_SingleStringGetter, (void*)items_separated_by_zeros, items_count, height_in_items);
-    return value_changed;
+    ImGuiContext& g = *GImGui;
+    const char* preview_value = (*current_item >= 0) ? Items_SingleStringGetter((void*)items_separated_by_zeros, *current_item) : NULL;
+    if (height_in_items != -1 && !(g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasSizeConstraint))
+        SetNextWindowSizeConstraints(ImVec2(0, 0), ImVec2(FLT_MAX, CalcMaxPopupHeightFromItemCount(height_in_items)));
+
+    if (!BeginCombo(label, preview_value, ImGuiComboFlags_None))
+        return false;
+
+    ImGuiComboItemsScratch* scratch = &g.ComboItemsScratch;
+    scratch->Source = items_separated_by_zeros;
+    scratch->Offsets.resize(0);
+    for (const char* p = items_separated_by_zeros; *p; p += strlen(p) + 1)
+        scratch->Offsets.push_back((int)(p - items_separated_by_zeros));
+    return ComboItemsAndEnd(current_item, Items_SingleStringOffsetsGetter, (void*)scratch, scratch->Offsets.Size);
 }
 
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
@@ -2181,8 +2257,86 @@ const ImGuiDataTypeInfo* ImGui::DataTypeGetInfo(ImGuiDataType data_type)
     return &GDataTypeInfo[data_type];
 }
 
+#if !defined(IMGUI_DISABLE_DEFAULT_FORMAT_FUNCTIONS) && !defined(IMGUI_USE_STB_SPRINTF)
+// Fast path for the most common display formats "%d", "%u", "%f" and "%.Nf", bypassing vsnprintf().
+// Output is identical to printf(): we bail out on values which are out of range or close to a rounding tie (as tie handling depends on the C runtime).
+// The decimal point is taken from the current C locale (LC_NUMERIC) like printf() does, we bail out if it is not a single character.
+// Return -1 when not handled.
+static int DataTypeFormatStringFast(char* buf, int buf_size, ImGuiDataType data_type, const void* p_data, const char* format)
+{
+    if (format[0] != '%')
+        return -1;
+    char tmp[24];
+    char* p = tmp + IM_ARRAYSIZE(tmp); // Write backward
+    bool negative = false;
+    if ((format[1] == 'd' || format[1] == 'u') && format[2] == 0 && data_type <= ImGuiDataType_U32)
+    {
+        // Emulate integer promotion in va_arg
+        ImU32 v = 0;
+        switch (data_type)
+        {
+        case ImGuiDataType_S8:  v = (ImU32)(int)*(const ImS8*)p_data; break;
+        case ImGuiDataType_U8:  v = *(const ImU8*)p_data; break;
+        case ImGuiDataType_S16: v = (ImU32)(int)*(const ImS16*)p_data; break;
+        case ImGuiDataType_U16: v = *(const ImU16*)p_data; break;
+        default:                v = *(const ImU32*)p_data; break;
+        }
+        if (format[1] == 'd' && (v & 0x80000000u))
+        {
+            negative = true;
+            v = 0u - v;
+        }
+        do { *--p = (char)('0' + v % 10); v /= 10; } while (v != 0);
+    }
+    else if ((data_type == ImGuiDataType_Float || data_type == ImGuiDataType_Double) && ((format[1] == 'f' && format[2] == 0) || (format[1] == '.' && format[2] >= '0' && format[2] <= '9' && format[3] == 'f' && format[4] == 0)))
+    {
+        static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+        const int precision = (format[1] == 'f') ? 6 : format[2] - '0';
+        const char* decimal_point = localeconv()->decimal_point;
+        if (decimal_point[0] == 0 || decimal_point[1] != 0)
+            return -1;
+        const double v = (data_type == ImGuiDataType_Float) ? (double)*(const float*)p_data : *(const double*)p_data;
+        const double scaled = ImAbs(v) * pow10[precision]; // Exact for floats. For doubles, error is < 2^-22 in this range.
+        if (!(scaled < 2147483647.0)) // Also rejects NaN
+            return -1;
+        ImU32 digits = (ImU32)scaled;
+        const double frac = scaled - (double)digits;
+        if (ImAbs(frac - 0.5) <= 1e-6)
+            return -1;
+        if (frac > 0.5)
+            digits++;
+        ImU64 v_bits;
+        memcpy(&v_bits, &v, sizeof(v_bits));
+        negative = (v_bits >> 63) != 0; // printf() outputs "-0.000" for negative values rounding to zero, as well as for -0.0.
+        for (int n = 0; n < precision; n++, digits /= 10)
+            *--p = (char)('0' + digits % 10);
+        if (precision > 0)
+            *--p = decimal_point[0];
+        do { *--p = (char)('0' + digits % 10); digits /= 10; } while (digits != 0);
+    }
+    else
+    {
+        return -1;
+    }
+    if (negative)
+        *--p = '-';
+    const int len = (int)(tmp + IM_ARRAYSIZE(tmp) - p);
+    if (len >= buf_size)
+        return -1;
+    memcpy(buf, p, (size_t)len);
+    buf[len] = 0;
+    return len;
+}
+#endif
+
 int ImGui::DataTypeFormatString(char* buf, int buf_size, ImGuiDataType data_type, const void* p_data, const char* format)
 {
+#if !defined(IMGUI_DISABLE_DEFAULT_FORMAT_FUNCTIONS) && !defined(IMGUI_USE_STB_SPRINTF)
+    const int fast_len = DataTypeFormatStringFast(buf, buf_size, data_type, p_data, format);
+    if (fast_len >= 0)
+        return fast_len;
+#endif
+
     // Signedness doesn't matter when pushing integer arguments
     if (data_type == ImGuiDataType_S32 || data_type == ImGuiDataType_U32)
         return ImFormatString(buf, buf_size, format, *(const ImU32*)p_data);
@@ -3927,6 +4081,38 @@ static ImVec2 InputTextCalcTextSize(ImGuiContext* ctx, const char* text_begin, c
     return text_size;
 }
 
+// Return line index of a multi-line text edit state, (re)building it if text was replaced. Return NULL for single-line.
+static ImGuiInputTextLineIndex* InputTextGetLineIndex(ImGuiInputTextState* state)
+{
+    if (state->Stb->single_line)
+        return NULL;
+    ImGuiInputTextLineIndex* line_index = &state->LineIndex;
+    if (!line_index->Valid)
+        line_index->Build(state->TextA.Data, state->CurLenA);
+    IM_ASSERT(line_index->TextLen == state->CurLenA);
+    return line_index;
+}
+
+// Return width of a line of multi-line text. Only lines modified since last call (or all lines after a font change) are measured.
+static float InputTextGetLineWidth(ImGuiInputTextState* state, ImGuiInputTextLineIndex* line_index, int line_no)
+{
+    ImGuiContext& g = *state->Ctx;
+    if (line_index->WidthsFont != g.Font || line_index->WidthsFontSize != g.FontSize)
+    {
+        for (int n = 0; n < line_index->Widths.Size; n++)
+            line_index->Widths.Data[n] = -1.0f;
+        line_index->WidthsFont = g.Font;
+        line_index->WidthsFontSize = g.FontSize;
+    }
+    float* p_width = &line_index->Widths.Data[line_index->GetLineSlot(line_no)];
+    if (*p_width < 0.0f)
+    {
+        const char* text = state->TextA.Data;
+        *p_width = InputTextCalcTextSize(&g, text + line_index->GetLineStart(line_no), text + line_index->GetLineEnd(line_no), NULL, NULL, true).x;
+    }
+    return *p_width;
+}
+
 // Wrapper for stb_textedit.h to edit text (our wrapper is for: statically sized buffer, single-line, wchar characters. InputText converts between UTF-8 and wchar)
 // With our UTF-8 use of stb_textedit:
 // - STB_TEXTEDIT_GETCHAR is nothing more than a a "GETBYTE". It's only used to compare to ascii or to copy blocks of text so we are fine.
@@ -3940,6 +4126,22 @@ static float   STB_TEXTEDIT_GETWIDTH(ImGuiInputTextState* obj, int line_start_id
 static char    STB_TEXTEDIT_NEWLINE = '\n';
 static void    STB_TEXTEDIT_LAYOUTROW(StbTexteditRow* r, ImGuiInputTextState* obj, int line_start_idx)
 {
+    // Multi-line: rows always start at the beginning of a line, we can use the line index and cached widths
+    if (ImGuiInputTextLineIndex* line_index = InputTextGetLineIndex(obj))
+    {
+        const int line_no = line_index->FindLine(line_start_idx);
+        if (line_index->GetLineStart(line_no) == line_start_idx)
+        {
+            r->x0 = 0.0f;
+            r->x1 = InputTextGetLineWidth(obj, line_index, line_no);
+            r->baseline_y_delta = obj->Ctx->FontSize;
+            r->ymin = 0.0f;
+            r->ymax = obj->Ctx->FontSize;
+            r->num_chars = line_index->GetLineEnd(line_no) - line_start_idx;
+            return;
+        }
+    }
+
     const char* text = obj->TextA.Data;
     const char* text_remaining = NULL;
     const ImVec2 size = InputTextCalcTextSize(obj->Ctx, text + line_start_idx, text + obj->CurLenA, &text_remaining, NULL, true);
@@ -4044,18 +4246,43 @@ static int  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL(ImGuiInputTextState* obj, int idx)
 #define STB_TEXTEDIT_MOVEWORDLEFT       STB_TEXTEDIT_MOVEWORDLEFT_IMPL  // They need to be #define for stb_textedit.h
 #define STB_TEXTEDIT_MOVEWORDRIGHT      STB_TEXTEDIT_MOVEWORDRIGHT_IMPL
 
+// Multi-line: use line index to skip rows, instead of stb_textedit.h laying out every row from the start of text.
+// We stop one row early and let stb_textedit.h handle the last rows (e.g. special handling of last line).
+static void STB_TEXTEDIT_SEEKROW_CHAR_IMPL(ImGuiInputTextState* obj, int n, int* row_start, int* prev_row_start, float* row_y)
+{
+    ImGuiInputTextLineIndex* line_index = InputTextGetLineIndex(obj);
+    const int line_no = line_index ? line_index->FindLine(n) - 1 : 0;
+    if (line_no <= 0)
+        return;
+    *row_start = line_index->GetLineStart(line_no);
+    *prev_row_start = line_index->GetLineStart(line_no - 1);
+    *row_y = line_no * obj->Ctx->FontSize;
+}
+
+static void STB_TEXTEDIT_SEEKROW_Y_IMPL(ImGuiInputTextState* obj, float y, int* row_start, float* row_y)
+{
+    ImGuiInputTextLineIndex* line_index = InputTextGetLineIndex(obj);
+    const int line_no = line_index ? ImMin((int)(y / obj->Ctx->FontSize) - 1, line_index->GetLineCount() - 1) : 0;
+    if (line_no <= 0)
+        return;
+    *row_start = line_index->GetLineStart(line_no);
+    *row_y = line_no * obj->Ctx->FontSize;
+}
+#define STB_TEXTEDIT_SEEKROW_CHAR       STB_TEXTEDIT_SEEKROW_CHAR_IMPL
+#define STB_TEXTEDIT_SEEKROW_Y          STB_TEXTEDIT_SEEKROW_Y_IMPL
+
 static void STB_TEXTEDIT_DELETECHARS(ImGuiInputTextState* obj, int pos, int n)
 {
     char* dst = obj->TextA.Data + pos;
 
-    obj->Edited = true;
+    obj->Edited = obj->UserBufDirty = true;
+    obj->CallbackTextBackupValid = false;
     obj->CurLenA -= n;
+    if (obj->LineIndex.Valid)
+        obj->LineIndex.OnDeleteChars(pos, n);
 
-    // Offset remaining text (FIXME-OPT: Use memmove)
-    const char* src = obj->TextA.Data + pos + n;
-    while (char c = *src++)
-        *dst++ = c;
-    *dst = '\0';
+    // Offset remaining text, including zero-terminator
+    memmove(dst, dst + n, (size_t)(obj->CurLenA - pos + 1));
 }
 
 static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const char* new_text, int new_text_len)
@@ -4080,13 +4307,72 @@ static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const ch
         memmove(text + pos + new_text_len, text + pos, (size_t)(text_len - pos));
     memcpy(text + pos, new_text, (size_t)new_text_len);
 
-    obj->Edited = true;
+    obj->Edited = obj->UserBufDirty = true;
+    obj->CallbackTextBackupValid = false;
     obj->CurLenA += new_text_len;
     obj->TextA[obj->CurLenA] = '\0';
+    if (obj->LineIndex.Valid)
+        obj->LineIndex.OnInsertChars(pos, new_text, new_text_len);
 
     return true;
 }
 
+// Undo/redo history is stored in ImGuiInputTextState::UndoStack (IMSTB_TEXTEDIT_UNDO_EXTERNAL)
+static void STB_TEXTEDIT_MAKEUNDO_IMPL(ImGuiInputTextState* obj, int where, int old_length, const char* new_text, int new_length)
+{
+    ImGuiContext& g = *obj->Ctx;
+    const int memory_max = (obj->Flags & ImGuiInputTextFlags_NoUndoRedo) ? 0 : g.IO.ConfigInputTextUndoMemoryMax;
+    obj->UndoStack.AddRecord(where, obj->TextA.Data + where, old_length, new_text, new_length, memory_max);
+}
+
+static int STB_TEXTEDIT_UNDO_IMPL(ImGuiInputTextState* obj)
+{
+    ImGuiInputTextUndoStack* undo_stack = &obj->UndoStack;
+    if (undo_stack->GetUndoCount() == 0)
+        return -1;
+    const ImGuiInputTextUndoRecord rec = undo_stack->Records[--undo_stack->UndoPoint];
+    undo_stack->LastTyping = false;
+    if (rec.Where + rec.NewLen > obj->CurLenA)
+    {
+        undo_stack->Clear(); // Text was modified without going through the undo stack
+        return -1;
+    }
+    if (rec.NewLen > 0)
+        STB_TEXTEDIT_DELETECHARS(obj, rec.Where, rec.NewLen);
+    if (rec.OldLen > 0 && !STB_TEXTEDIT_INSERTCHARS(obj, rec.Where, undo_stack->Text.Data + rec.TextOffset, rec.OldLen))
+    {
+        undo_stack->Clear();
+        return rec.Where;
+    }
+    return rec.Where + rec.OldLen;
+}
+
+static int STB_TEXTEDIT_REDO_IMPL(ImGuiInputTextState* obj)
+{
+    ImGuiInputTextUndoStack* undo_stack = &obj->UndoStack;
+    if (undo_stack->GetRedoCount() == 0)
+        return -1;
+    const ImGuiInputTextUndoRecord rec = undo_stack->Records[undo_stack->UndoPoint++];
+    undo_stack->LastTyping = false;
+    if (rec.Where + rec.OldLen > obj->CurLenA)
+    {
+        undo_stack->Clear();
+        return -1;
+    }
+    if (rec.OldLen > 0)
+        STB_TEXTEDIT_DELETECHARS(obj, rec.Where, rec.OldLen);
+    if (rec.NewLen > 0 && !STB_TEXTEDIT_INSERTCHARS(obj, rec.Where, undo_stack->Text.Data + rec.TextOffset + rec.OldLen, rec.NewLen))
+    {
+        undo_stack->Clear();
+        return rec.Where;
+    }
+    return rec.Where + rec.NewLen;
+}
+
+#define STB_TEXTEDIT_MAKEUNDO           STB_TEXTEDIT_MAKEUNDO_IMPL
+#define STB_TEXTEDIT_UNDO               STB_TEXTEDIT_UNDO_IMPL
+#define STB_TEXTEDIT_REDO               STB_TEXTEDIT_REDO_IMPL
+
 // We don't use an enum so we can build even with conflicting symbols (if another user of stb_textedit.h leak their STB_TEXTEDIT_K_* symbols)
 #define STB_TEXTEDIT_K_LEFT         0x200000 // keyboard input to move cursor left
 #define STB_TEXTEDIT_K_RIGHT        0x200001 // keyboard input to move cursor right
@@ -4114,7 +4400,7 @@ static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const ch
 // the stb_textedit_paste() function creates two separate records, so we perform it manually. (FIXME: Report to nothings/stb?)
 static void stb_textedit_replace(ImGuiInputTextState* str, STB_TexteditState* state, const IMSTB_TEXTEDIT_CHARTYPE* text, int text_len)
 {
-    stb_text_makeundo_replace(str, state, 0, str->CurLenA, text_len);
+    stb_text_makeundo_replace(str, state, 0, str->CurLenA, text, text_len);
     ImStb::STB_TEXTEDIT_DELETECHARS(str, 0, str->CurLenA);
     state->cursor = state->select_start = state->select_end = 0;
     if (text_len <= 0)
@@ -4145,7 +4431,11 @@ ImGuiInputTextState::~ImGuiInputTextState()
 
 void ImGuiInputTextState::OnKeyPressed(int key)
 {
+    // Deleting a single character may be coalesced with previous typing in undo stack
+    const int key_no_shift = key & ~STB_TEXTEDIT_K_SHIFT;
+    UndoStack.Typing = (key_no_shift == STB_TEXTEDIT_K_BACKSPACE || key_no_shift == STB_TEXTEDIT_K_DELETE) && !HasSelection();
     stb_textedit_key(this, Stb, key);
+    UndoStack.Typing = false;
     CursorFollow = true;
     CursorAnimReset();
 }
@@ -4156,7 +4446,9 @@ void ImGuiInputTextState::OnCharPressed(unsigned int c)
     // The changes we had to make to stb_textedit_key made it very much UTF-8 specific which is not too great.
     char utf8[5];
     ImTextCharToUtf8(utf8, c);
+    UndoStack.Typing = !HasSelection();
     stb_textedit_text(this, Stb, utf8, (int)strlen(utf8));
+    UndoStack.Typing = false;
     CursorFollow = true;
     CursorAnimReset();
 }
@@ -4174,6 +4466,214 @@ void ImGuiInputTextState::ReloadUserBufAndSelectAll()       { ReloadUserBuf = tr
 void ImGuiInputTextState::ReloadUserBufAndKeepSelection()   { ReloadUserBuf = true; ReloadSelectionStart = Stb->select_start; ReloadSelectionEnd = Stb->select_end; }
 void ImGuiInputTextState::ReloadUserBufAndMoveToEnd()       { ReloadUserBuf = true; ReloadSelectionStart = ReloadSelectionEnd = INT_MAX; }
 
+// Binary search for the last line starting at or before 'offset'. Line 0 always starts at 0.
+int ImGuiInputTextLineIndex::FindLine(int offset) const
+{
+    IM_ASSERT(Valid);
+    int lo = 0, hi = GetLineCount() - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi + 1) >> 1;
+        if (GetLineStart(mid) <= offset)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
+void ImGuiInputTextLineIndex::Build(const char* text, int text_len)
+{
+    Offsets.resize(0);
+    Offsets.push_back(0);
+    for (const char* s = text; (s = (const char*)memchr(s, '\n', (size_t)(text + text_len - s))) != NULL; s++)
+        Offsets.push_back((int)(s - text) + 1);
+    Widths.resize(Offsets.Size);
+    for (int n = 0; n < Widths.Size; n++)
+        Widths.Data[n] = -1.0f;
+    GapBegin = GapEnd = Offsets.Size;
+    TextLen = text_len;
+    Valid = true;
+}
+
+// Move gap so that it sits before 'line_no'. Cost is proportional to the number of lines crossed.
+void ImGuiInputTextLineIndex::MoveGap(int line_no)
+{
+    IM_ASSERT(line_no >= 0 && line_no <= GetLineCount());
+    while (GapBegin > line_no)
+    {
+        GapBegin--;
+        GapEnd--;
+        Offsets.Data[GapEnd] = TextLen - Offsets.Data[GapBegin];
+        Widths.Data[GapEnd] = Widths.Data[GapBegin];
+    }
+    while (GapBegin < line_no)
+    {
+        Offsets.Data[GapBegin] = TextLen - Offsets.Data[GapEnd];
+        Widths.Data[GapBegin] = Widths.Data[GapEnd];
+        GapBegin++;
+        GapEnd++;
+    }
+}
+
+// Lines starting after 'pos' are shifted by 'new_text_len' by virtue of being stored relative to end of text.
+void ImGuiInputTextLineIndex::OnInsertChars(int pos, const char* new_text, int new_text_len)
+{
+    MoveGap(FindLine(pos) + 1);
+    TextLen += new_text_len;
+    Widths.Data[GapBegin - 1] = -1.0f;
+    for (const char* s = new_text; (s = (const char*)memchr(s, '\n', (size_t)(new_text + new_text_len - s))) != NULL; s++)
+    {
+        if (GapBegin == GapEnd)
+        {
+            // Grow gap
+            const int tail_count = Offsets.Size - GapEnd;
+            const int new_size = Offsets.Size + ImMax(Offsets.Size / 2, 16);
+            Offsets.resize(new_size);
+            Widths.resize(new_size);
+            memmove(Offsets.Data + new_size - tail_count, Offsets.Data + GapEnd, (size_t)tail_count * sizeof(int));
+            memmove(Widths.Data + new_size - tail_count, Widths.Data + GapEnd, (size_t)tail_count * sizeof(float));
+            GapEnd = new_size - tail_count;
+        }
+        Offsets.Data[GapBegin] = pos + (int)(s - new_text) + 1;
+        Widths.Data[GapBegin] = -1.0f;
+        GapBegin++;
+    }
+}
+
+// Lines starting in (pos, pos + n] had their preceding '\n' deleted.
+void ImGuiInputTextLineIndex::OnDeleteChars(int pos, int n)
+{
+    MoveGap(FindLine(pos) + 1);
+    while (GapEnd < Offsets.Size && TextLen - Offsets.Data[GapEnd] <= pos + n)
+        GapEnd++;
+    TextLen -= n;
+    Widths.Data[GapBegin - 1] = -1.0f;
+}
+
+// Record replacement of 'old_len' bytes at 'where' (read from 'old_text', before they are deleted) with 'new_len' bytes from 'new_text'.
+void ImGuiInputTextUndoStack::AddRecord(int where, const char* old_text, int old_len, const char* new_text, int new_len, int memory_max)
+{
+    IM_ASSERT(old_len >= 0 && new_len >= 0);
+    if (old_len == 0 && new_len == 0)
+        return;
+
+    // Discard redo records
+    if (UndoPoint < Records.Size)
+    {
+        Text.resize(Records[UndoPoint].TextOffset);
+        Records.resize(UndoPoint);
+    }
+
+    // Older records can't be applied without this one, so discard everything if it doesn't fit
+    if ((int)sizeof(ImGuiInputTextUndoRecord) + old_len + new_len > memory_max)
+    {
+        Clear();
+        return;
+    }
+
+    if (!Typing || !LastTyping || !MergeRecord(where, old_text, old_len, new_text, new_len))
+    {
+        ImGuiInputTextUndoRecord rec;
+        rec.Where = where;
+        rec.OldLen = old_len;
+        rec.NewLen = new_len;
+        rec.TextOffset = Text.Size;
+        Records.push_back(rec);
+        Text.resize(Text.Size + old_len + new_len);
+        if (old_len > 0)
+            memcpy(Text.Data + rec.TextOffset, old_text, (size_t)old_len);
+        if (new_len > 0)
+            memcpy(Text.Data + rec.TextOffset + old_len, new_text, (size_t)new_len);
+    }
+    UndoPoint = Records.Size;
+    LastTyping = Typing;
+    DiscardOldest(memory_max);
+}
+
+// Typing splits records at the start of each word: 'prev_c' is the last character typed (or deleted), 'c' the new one.
+static bool InputTextUndoIsWordStart(char prev_c, char c)
+{
+    const bool prev_blank = (prev_c == ' ' || prev_c == '\t' || prev_c == '\n');
+    const bool blank = (c == ' ' || c == '\t' || c == '\n');
+    return prev_blank && !blank;
+}
+
+// Try to coalesce edit into last record, which is the last one stored in Text[].
+bool ImGuiInputTextUndoStack::MergeRecord(int where, const char* old_text, int old_len, const char* new_text, int new_len)
+{
+    if (RecordsBegin == Records.Size)
+        return false;
+    ImGuiInputTextUndoRecord* last = &Records.back();
+    IM_ASSERT(last->TextOffset + last->OldLen + last->NewLen == Text.Size);
+
+    // Typing, overwrite typing or Delete: edit starts where last one ended.
+    // Old text is appended to old text, new text is appended to new text.
+    if (where == last->Where + last->NewLen)
+    {
+        const char* last_text = Text.Data + last->TextOffset;
+        const char prev_c = (last->NewLen > 0) ? last_text[last->OldLen + last->NewLen - 1] : last_text[last->OldLen - 1];
+        const char c = (new_len > 0) ? new_text[0] : old_text[0];
+        if (InputTextUndoIsWordStart(prev_c, c))
+            return false;
+        Text.resize(Text.Size + old_len + new_len);
+        char* last_new_text = Text.Data + last->TextOffset + last->OldLen;
+        if (old_len > 0)
+        {
+            memmove(last_new_text + old_len, last_new_text, (size_t)last->NewLen);
+            memcpy(last_new_text, old_text, (size_t)old_len);
+        }
+        if (new_len > 0)
+            memcpy(last_new_text + old_len + last->NewLen, new_text, (size_t)new_len);
+        last->OldLen += old_len;
+        last->NewLen += new_len;
+        return true;
+    }
+
+    // Backspace after typing: remove from typed text.
+    if (new_len == 0 && old_len <= last->NewLen && where + old_len == last->Where + last->NewLen)
+    {
+        Text.resize(Text.Size - old_len);
+        last->NewLen -= old_len;
+        if (last->OldLen == 0 && last->NewLen == 0)
+            Records.pop_back();
+        return true;
+    }
+
+    // Backspace after Backspace: prepend to old text.
+    if (new_len == 0 && last->NewLen == 0 && where + old_len == last->Where)
+    {
+        if (InputTextUndoIsWordStart(Text.Data[last->TextOffset], old_text[old_len - 1]))
+            return false;
+        Text.resize(Text.Size + old_len);
+        char* last_old_text = Text.Data + last->TextOffset;
+        memmove(last_old_text + old_len, last_old_text, (size_t)last->OldLen);
+        memcpy(last_old_text, old_text, (size_t)old_len);
+        last->Where = where;
+        last->OldLen += old_len;
+        return true;
+    }
+    return false;
+}
+
+// Discard oldest records to fit within 'memory_max'. Space is reclaimed once it reaches half of the buffers.
+void ImGuiInputTextUndoStack::DiscardOldest(int memory_max)
+{
+    while (RecordsBegin < Records.Size && GetMemoryUsage() > memory_max)
+        RecordsBegin++;
+    if (RecordsBegin == 0)
+        return;
+    const int text_begin = (RecordsBegin < Records.Size) ? Records[RecordsBegin].TextOffset : Text.Size;
+    if (RecordsBegin < Records.Size / 2 && text_begin < Text.Size / 2)
+        return;
+    Records.erase(Records.Data, Records.Data + RecordsBegin);
+    Text.erase(Text.Data, Text.Data + text_begin);
+    for (ImGuiInputTextUndoRecord& rec : Records)
+        rec.TextOffset -= text_begin;
+    UndoPoint -= RecordsBegin;
+    RecordsBegin = 0;
+}
+
 ImGuiInputTextCallbackData::ImGuiInputTextCallbackData()
 {
     memset(this, 0, sizeof(*this));
@@ -4338,10 +4838,10 @@ static bool InputTextFilterCharacter(ImGuiContext* ctx, unsigned int* p_char, Im
 }
 
 // Find the shortest single replacement we can make to get the new text from the old text.
-// Important: needs to be run before TextW is rewritten with the new characters because calling STB_TEXTEDIT_GETCHAR() at the end.
 // FIXME: Ideally we should transition toward (1) making InsertChars()/DeleteChars() update undo-stack (2) discourage (and keep reconcile) or obsolete (and remove reconcile) accessing buffer directly.
 static void InputTextReconcileUndoStateAfterUserCallback(ImGuiInputTextState* state, const char* new_buf_a, int new_length_a)
 {
+    ImGuiContext& g = *state->Ctx;
     const char* old_buf = state->CallbackTextBackup.Data;
     const int old_length = state->CallbackTextBackup.Size - 1;
 
@@ -4361,10 +4861,8 @@ static void InputTextReconcileUndoStateAfterUserCallback(ImGuiInputTextState* st
 
     const int insert_len = new_last_diff - first_diff + 1;
     const int delete_len = old_last_diff - first_diff + 1;
-    if (insert_len > 0 || delete_len > 0)
-        if (IMSTB_TEXTEDIT_CHARTYPE* p = stb_text_createundo(&state->Stb->undostate, first_diff, delete_len, insert_len))
-            for (int i = 0; i < delete_len; i++)
-                p[i] = old_buf[first_diff + i];
+    const int memory_max = (state->Flags & ImGuiInputTextFlags_NoUndoRedo) ? 0 : g.IO.ConfigInputTextUndoMemoryMax;
+    state->UndoStack.AddRecord(first_diff, old_buf + first_diff, delete_len, new_buf_a + first_diff, insert_len, memory_max);
 }
 
 // As InputText() retain textual data and we currently provide a path for user to not retain it (via local variables)
@@ -4541,6 +5039,10 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->TextA.resize(buf_size + 1);          // we use +1 to make sure that .Data is always pointing to at least an empty string.
         state->CurLenA = (int)strlen(buf);
         memcpy(state->TextA.Data, buf, state->CurLenA + 1);
+        state->LineIndex.Valid = false;
+        state->UserBufDirty = false;
+        state->CallbackTextBackupValid = false;
+        state->UndoStack.LastTyping = false;
 
         if (recycle_state)
         {
@@ -4552,6 +5054,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         {
             state->Scroll = ImVec2(0.0f, 0.0f);
             stb_textedit_initialize_state(state->Stb, !is_multiline);
+            state->UndoStack.Clear();
         }
 
         if (init_reload_from_user_buf)
@@ -4897,7 +5400,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 // Filter pasted buffer
                 const int clipboard_len = (int)strlen(clipboard);
-                char* clipboard_filtered = (char*)IM_ALLOC(clipboard_len + 1);
+                char* clipboard_filtered = (char*)MemAllocFrame(clipboard_len + 1, 1);
                 int clipboard_filtered_len = 0;
                 for (const char* s = clipboard; *s != 0; )
                 {
@@ -4915,7 +5418,6 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     stb_textedit_paste(state, state->Stb, clipboard_filtered, clipboard_filtered_len);
                     state->CursorFollow = true;
                 }
-                MemFree(clipboard_filtered);
             }
         }
 
@@ -4965,7 +5467,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             // Apply new value immediately - copy modified buffer back
             // Note that as soon as the input box is active, the in-widget value gets priority over any underlying modification of the input buffer
             // FIXME: We actually always render 'buf' when calling DrawList->AddText, making the comment above incorrect.
-            // FIXME-OPT: CPU waste to do this every time the widget is active, should mark dirty state from the stb_textedit callbacks.
+            // Modifications are tracked with 'state->UserBufDirty', set from the stb_textedit callbacks.
 
             // User callback
             if ((flags & (ImGuiInputTextFlags_CallbackCompletion | ImGuiInputTextFlags_CallbackHistory | ImGuiInputTextFlags_CallbackEdit | ImGuiInputTextFlags_CallbackAlways)) != 0)
@@ -5007,9 +5509,14 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     callback_data.Flags = flags;
                     callback_data.UserData = callback_user_data;
 
-                    // FIXME-OPT: Undo stack reconcile needs a backup of the data until we rework API, see #7925
-                    state->CallbackTextBackup.resize(state->CurLenA + 1);
-                    memcpy(state->CallbackTextBackup.Data, state->TextA.Data, state->CurLenA + 1);
+                    // Undo stack reconcile needs a backup of the data until we rework API, see #7925.
+                    // It is only refreshed when text changed since last callback, so e.g. ImGuiInputTextFlags_CallbackAlways doesn't copy the buffer every frame.
+                    if (!state->CallbackTextBackupValid)
+                    {
+                        state->CallbackTextBackup.resize(state->CurLenA + 1);
+                        memcpy(state->CallbackTextBackup.Data, state->TextA.Data, state->CurLenA + 1);
+                        state->CallbackTextBackupValid = true;
+                    }
 
                     char* callback_buf = is_readonly ? buf : state->TextA.Data;
                     callback_data.EventKey = event_key;
@@ -5041,17 +5548,24 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                         InputTextReconcileUndoStateAfterUserCallback(state, callback_data.Buf, callback_data.BufTextLen); // FIXME: Move the rest of this block inside function and rename to InputTextReconcileStateAfterUserCallback() ?
                         state->CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
                         state->TextA.Size = state->CurLenA + 1;
+                        state->LineIndex.Valid = false;
+                        state->CallbackTextBackupValid = false;
+                        state->UserBufDirty = true;
                         state->CursorAnimReset();
                     }
                 }
             }
 
-            // Will copy result string if modified
-            if (!is_readonly && strcmp(state->TextA.Data, buf) != 0)
+            // Will copy result string if modified since last applied (always compare on validation, e.g. InputInt() with ImGuiInputTextFlags_EnterReturnsTrue)
+            if (!is_readonly && (state->UserBufDirty || validated))
             {
-                apply_new_text = state->TextA.Data;
-                apply_new_text_length = state->CurLenA;
-                value_changed = true;
+                if (strcmp(state->TextA.Data, buf) != 0)
+                {
+                    apply_new_text = state->TextA.Data;
+                    apply_new_text_length = state->CurLenA;
+                    value_changed = true;
+                }
+                state->UserBufDirty = false;
             }
         }
     }
@@ -5144,7 +5658,6 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         // We are attempting to do most of that in **one main pass** to minimize the computation cost (non-negligible for large amount of text) + 2nd pass for selection rendering (we could merge them by an extra refactoring effort)
         // FIXME: This should occur on buf_display but we'd need to maintain cursor/select_start/select_end for UTF-8.
         const char* text_begin = state->TextA.Data;
-        const char* text_end = text_begin + state->CurLenA;
         ImVec2 cursor_offset, select_start_offset;
 
         {
@@ -5155,15 +5668,29 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             const char* selmin_ptr = render_selection ? text_begin + ImMin(state->Stb->select_start, state->Stb->select_end) : NULL;
 
             // Count lines and find line number for cursor and selection ends
+            // (multi-line: use line index maintained by stb_textedit callbacks, only (re)built here when text was replaced)
             int line_count = 1;
+            const char* cursor_line_begin = NULL;
+            const char* selmin_line_begin = NULL;
             if (is_multiline)
             {
-                for (const char* s = text_begin; (s = (const char*)memchr(s, '\n', (size_t)(text_end - s))) != NULL; s++)
+                ImGuiInputTextLineIndex* line_index = InputTextGetLineIndex(state);
+                line_count = line_index->GetLineCount();
+                if (cursor_ptr)
                 {
-                    if (cursor_line_no == -1 && s >= cursor_ptr) { cursor_line_no = line_count; }
-                    if (selmin_line_no == -1 && s >= selmin_ptr) { selmin_line_no = line_count; }
-                    line_count++;
+                    cursor_line_no = line_index->FindLine((int)(cursor_ptr - text_begin));
+                    cursor_line_begin = text_begin + line_index->GetLineStart(cursor_line_no++);
                 }
+                if (selmin_ptr)
+                {
+                    selmin_line_no = line_index->FindLine((int)(selmin_ptr - text_begin));
+                    selmin_line_begin = text_begin + line_index->GetLineStart(selmin_line_no++);
+                }
+            }
+            else
+            {
+                cursor_line_begin = ImStrbol(cursor_ptr, text_begin);
+                selmin_line_begin = ImStrbol(selmin_ptr, text_begin);
             }
             if (cursor_line_no == -1)
                 cursor_line_no = line_count;
@@ -5171,11 +5698,11 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 selmin_line_no = line_count;
 
             // Calculate 2d position by finding the beginning of the line and measuring distance
-            cursor_offset.x = InputTextCalcTextSize(&g, ImStrbol(cursor_ptr, text_begin), cursor_ptr).x;
+            cursor_offset.x = InputTextCalcTextSize(&g, cursor_line_begin, cursor_ptr).x;
             cursor_offset.y = cursor_line_no * g.FontSize;
             if (selmin_line_no >= 0)
             {
-                select_start_offset.x = InputTextCalcTextSize(&g, ImStrbol(selmin_ptr, text_begin), selmin_ptr).x;
+                select_start_offset.x = InputTextCalcTextSize(&g, selmin_line_begin, selmin_ptr).x;
                 select_start_offset.y = selmin_line_no * g.FontSize;
             }
 
@@ -5230,7 +5757,21 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             float bg_offy_up = is_multiline ? 0.0f : -1.0f;    // FIXME: those offsets should be part of the style? they don't play so well with multi-line selection.
             float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
             ImVec2 rect_pos = draw_pos + select_start_offset - draw_scroll;
-            for (const char* p = text_selected_begin; p < text_selected_end; )
+            const char* p = text_selected_begin;
+            ImGuiInputTextLineIndex* line_index = is_multiline ? &state->LineIndex : NULL;
+            int line_no = line_index ? line_index->FindLine((int)(p - text_begin)) : 0;
+            if (line_index && rect_pos.y + g.FontSize < clip_rect.y)
+            {
+                // Skip most selected lines above visible area using line index (remaining ones are skipped below)
+                const int skip_count = ImMin((int)((clip_rect.y - rect_pos.y) / g.FontSize) - 1, line_index->GetLineCount() - 1 - line_no);
+                if (skip_count > 0)
+                {
+                    line_no += skip_count;
+                    p = ImMin(text_begin + line_index->GetLineStart(line_no), text_selected_end);
+                    rect_pos.y += skip_count * g.FontSize;
+                }
+            }
+            for (; p < text_selected_end; line_no++)
             {
                 if (rect_pos.y > clip_rect.w + g.FontSize)
                     break;
@@ -5241,7 +5782,17 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 }
                 else
                 {
-                    ImVec2 rect_size = InputTextCalcTextSize(&g, p, text_selected_end, &p, NULL, true);
+                    ImVec2 rect_size;
+                    if (line_index && p == text_begin + line_index->GetLineStart(line_no) && text_begin + line_index->GetLineEnd(line_no) <= text_selected_end)
+                    {
+                        // Fully selected line: use cached width
+                        rect_size.x = InputTextGetLineWidth(state, line_index, line_no);
+                        p = text_begin + line_index->GetLineEnd(line_no);
+                    }
+                    else
+                    {
+                        rect_size = InputTextCalcTextSize(&g, p, text_selected_end, &p, NULL, true);
+                    }
                     if (rect_size.x <= 0.0f) rect_size.x = IM_TRUNC(g.Font->GetCharAdvance((ImWchar)' ') * 0.50f); // So we can see selected empty lines
                     ImRect rect(rect_pos + ImVec2(0.0f, bg_offy_up - g.FontSize), rect_pos + ImVec2(rect_size.x, bg_offy_dn));
                     rect.ClipWith(clip_rect);
@@ -5254,11 +5805,24 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         }
 
         // We test for 'buf_display_max_length' as a way to avoid some pathological cases (e.g. single-line 1 MB string) which would make ImDrawList crash.
-        // FIXME-OPT: Multiline could submit a smaller amount of contents to AddText() since we already iterated through it.
+        // Multi-line only submits visible lines to AddText(), using line index.
+        // (buf_display/buf_display_end are left untouched: they are used for logging below)
+        ImVec2 text_pos = draw_pos - draw_scroll;
+        const char* draw_begin = buf_display;
+        const char* draw_end = buf_display_end;
+        if (is_multiline && !is_displaying_hint)
+        {
+            const int line_count = state->LineIndex.GetLineCount();
+            const int line_min = ImClamp((int)((draw_window->DrawList->GetClipRectMin().y - text_pos.y) / g.FontSize) - 1, 0, line_count - 1);
+            const int line_max = ImClamp((int)((draw_window->DrawList->GetClipRectMax().y - text_pos.y) / g.FontSize) + 1, line_min + 1, line_count);
+            draw_begin = buf_display + state->LineIndex.GetLineStart(line_min);
+            draw_end = buf_display + state->LineIndex.GetLineEnd(line_max - 1);
+            text_pos.y += line_min * g.FontSize;
+        }
         if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
         {
             ImU32 col = GetColorU32(is_displaying_hint ? ImGuiCol_TextDisabled : ImGuiCol_Text);
-            draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
+            draw_window->DrawList->AddText(g.Font, g.FontSize, text_pos, col, draw_begin, draw_end, 0.0f, is_multiline ? NULL : &clip_rect);
         }
 
         // Draw blinking cursor
@@ -5345,28 +5909,27 @@ void ImGui::DebugNodeInputTextState(ImGuiInputTextState* state)
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     ImGuiContext& g = *GImGui;
     ImStb::STB_TexteditState* stb_state = state->Stb;
-    ImStb::StbUndoState* undo_state = &stb_state->undostate;
+    ImGuiInputTextUndoStack* undo_stack = &state->UndoStack;
     Text("ID: 0x%08X, ActiveID: 0x%08X", state->ID, g.ActiveId);
     DebugLocateItemOnHover(state->ID);
     Text("CurLenA: %d, Cursor: %d, Selection: %d..%d", state->CurLenA, stb_state->cursor, stb_state->select_start, stb_state->select_end);
     Text("has_preferred_x: %d (%.2f)", stb_state->has_preferred_x, stb_state->preferred_x);
-    Text("undo_point: %d, redo_point: %d, undo_char_point: %d, redo_char_point: %d", undo_state->undo_point, undo_state->redo_point, undo_state->undo_char_point, undo_state->redo_char_point);
+    Text("LineIndex: %d lines, gap %d..%d%s", state->LineIndex.Valid ? state->LineIndex.GetLineCount() : 0, state->LineIndex.GapBegin, state->LineIndex.GapEnd, state->LineIndex.Valid ? "" : " (invalid)");
+    Text("UndoStack: %d undo, %d redo, memory %d/%d bytes", undo_stack->GetUndoCount(), undo_stack->GetRedoCount(), undo_stack->GetMemoryUsage(), g.IO.ConfigInputTextUndoMemoryMax);
     if (BeginChild("undopoints", ImVec2(0.0f, GetTextLineHeight() * 10), ImGuiChildFlags_Borders | ImGuiChildFlags_ResizeY)) // Visualize undo state
     {
         PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
-        for (int n = 0; n < IMSTB_TEXTEDIT_UNDOSTATECOUNT; n++)
-        {
-            ImStb::StbUndoRecord* undo_rec = &undo_state->undo_rec[n];
-            const char undo_rec_type = (n < undo_state->undo_point) ? 'u' : (n >= undo_state->redo_point) ? 'r' : ' ';
-            if (undo_rec_type == ' ')
-                BeginDisabled();
-            const int buf_preview_len = (undo_rec_type != ' ' && undo_rec->char_storage != -1) ? undo_rec->insert_length : 0;
-            const char* buf_preview_str = undo_state->undo_char + undo_rec->char_storage;
-            Text("%c [%02d] where %03d, insert %03d, delete %03d, char_storage %03d \"%.*s\"",
-                undo_rec_type, n, undo_rec->where, undo_rec->insert_length, undo_rec->delete_length, undo_rec->char_storage, buf_preview_len, buf_preview_str);
-            if (undo_rec_type == ' ')
-                EndDisabled();
-        }
+        ImGuiListClipper clipper;
+        clipper.Begin(undo_stack->Records.Size - undo_stack->RecordsBegin);
+        while (clipper.Step())
+            for (int n = undo_stack->RecordsBegin + clipper.DisplayStart; n < undo_stack->RecordsBegin + clipper.DisplayEnd; n++)
+            {
+                const ImGuiInputTextUndoRecord* undo_rec = &undo_stack->Records[n];
+                const char undo_rec_type = (n < undo_stack->UndoPoint) ? 'u' : 'r';
+                const char* rec_text = undo_stack->Text.Data + undo_rec->TextOffset;
+                Text("%c [%02d] where %03d, old %03d \"%.*s\", new %03d \"%.*s\"", undo_rec_type, n - undo_stack->RecordsBegin, undo_rec->Where,
+                    undo_rec->OldLen, ImMin(undo_rec->OldLen, 64), rec_text, undo_rec->NewLen, ImMin(undo_rec->NewLen, 64), rec_text + undo_rec->OldLen);
+            }
         PopStyleVar();
     }
     EndChild();
@@ -6313,6 +6876,7 @@ void ImGui::ColorPickerOptionsPopup(const float* ref_col, ImGuiColorEditFlags fl
 // - GetTreeNodeToLabelSpacing()
 // - SetNextItemOpen()
 // - CollapsingHeader()
+// - ImGuiTreeClipper
 //-------------------------------------------------------------------------
 
 bool ImGui::TreeNode(const char* str_id, const char* fmt, ...)
@@ -6868,6 +7432,237 @@ bool ImGui::CollapsingHeader(const char* label, bool* p_visible, ImGuiTreeNodeFl
     return is_open;
 }
 
+//-------------------------------------------------------------------------
+
+ImGuiTreeClipper::ImGuiTreeClipper()
+{
+    UserData = NULL;
+    AdapterGetChildCount = NULL;
+    AdapterGetChild = NULL;
+    AdapterGetFlags = NULL;
+    DisplayStart = DisplayEnd = 0;
+    _NeedRebuild = true;
+    _NavRow = _NavParentRow = -1;
+    _NavParentID = 0;
+    _NavParentItemFlags = 0;
+}
+
+struct ImGuiTreeClipperStackData
+{
+    void*   Node;
+    int     ChildCount;
+    int     NextChild;
+};
+
+// Append visible descendants of 'node' to 'out_rows', in display order. Open state is read from current window storage.
+// Uses an explicit stack instead of recursion, as the hierarchy may be arbitrarily deep.
+static void ImGuiTreeClipper_AddVisibleRows(ImGuiTreeClipper* tree, void* node, int child_count, int depth, ImVector<ImGuiTreeClipperRow>* out_rows)
+{
+    ImGuiWindow* window = GImGui->CurrentWindow;
+    ImGuiStorage* storage = window->DC.StateStorage;
+    ImVector<ImGuiTreeClipperStackData> stack;
+    ImGuiTreeClipperStackData root_data = { node, child_count, 0 };
+    stack.push_back(root_data);
+    while (stack.Size > 0)
+    {
+        ImGuiTreeClipperStackData* parent_data = &stack.back();
+        if (parent_data->NextChild == parent_data->ChildCount)
+        {
+            stack.pop_back();
+            continue;
+        }
+        ImGuiTreeClipperRow row;
+        row.Node = tree->AdapterGetChild(tree, parent_data->Node, parent_data->NextChild++);
+        IM_ASSERT(row.Node != NULL);
+        row.Depth = depth + stack.Size - 1;
+        row.ChildCount = tree->AdapterGetChildCount(tree, row.Node);
+        row.IsOpen = false;
+        if (row.ChildCount > 0)
+        {
+            const ImGuiTreeNodeFlags flags = tree->AdapterGetFlags ? tree->AdapterGetFlags(tree, row.Node) : ImGuiTreeNodeFlags_None;
+            row.IsOpen = storage->GetInt(window->GetID(row.Node), (flags & ImGuiTreeNodeFlags_DefaultOpen) ? 1 : 0) != 0; // Same as TreeNodeUpdateNextOpen()
+        }
+        out_rows->push_back(row);
+        if (row.IsOpen)
+        {
+            ImGuiTreeClipperStackData child_data = { row.Node, row.ChildCount, 0 };
+            stack.push_back(child_data);
+        }
+    }
+}
+
+static int ImGuiTreeClipper_CompareRowsDescending(const int& lhs, const int& rhs)
+{
+    return rhs - lhs;
+}
+
+// Update a row index stored by multi-select after rows [row_n+1, end_n) were replaced with 'delta' more rows.
+static void ImGuiTreeClipper_RemapSelectionUserData(ImGuiSelectionUserData* p_row, int row_n, int end_n, int delta, ImGuiSelectionUserData hidden_value)
+{
+    if (*p_row == ImGuiSelectionUserData_Invalid || *p_row <= row_n)
+        return;
+    *p_row = (*p_row < end_n) ? hidden_value : *p_row + delta;
+}
+
+// Rows toggled during last frame are processed from last to first, so indices of rows left to process are not affected.
+// Opening a row inserts its visible descendants after it, closing it removes them.
+// When inside a BeginMultiSelect() scope, row indices it stores are remapped the same way as _NavRow. A RangeSrcItem which
+// got hidden moves to its closed ancestor, so SHIFT+Click after closing a node still extends from the same place.
+static void ImGuiTreeClipper_ApplyToggledRows(ImGuiTreeClipper* tree, ImGuiMultiSelectTempData* ms)
+{
+    ImVector<ImGuiTreeClipperRow>& rows = tree->Rows;
+    ImVector<int>& toggled = tree->_ToggledRows;
+    ImSort<int, ImGuiTreeClipper_CompareRowsDescending>(toggled.Data, toggled.Size);
+
+    ImVector<ImGuiTreeClipperRow> new_rows;
+    for (int toggled_n = 0; toggled_n < toggled.Size; toggled_n++)
+    {
+        const int row_n = toggled[toggled_n];
+        if (row_n >= rows.Size || (toggled_n > 0 && toggled[toggled_n - 1] == row_n))
+            continue;
+        const ImGuiTreeClipperRow row = rows[row_n];
+
+        // Remove rows currently displayed as descendants
+        int end_n = row_n + 1;
+        while (end_n < rows.Size && rows[end_n].Depth > row.Depth)
+            end_n++;
+
+        // Insert visible descendants
+        new_rows.resize(0);
+        if (row.IsOpen)
+            ImGuiTreeClipper_AddVisibleRows(tree, row.Node, row.ChildCount, row.Depth + 1, &new_rows);
+
+        const int tail_count = rows.Size - end_n;
+        const int delta = new_rows.Size - (end_n - (row_n + 1));
+        if (delta > 0)
+            rows.resize(rows.Size + delta);
+        memmove(rows.Data + row_n + 1 + new_rows.Size, rows.Data + end_n, (size_t)tail_count * sizeof(ImGuiTreeClipperRow));
+        if (delta < 0)
+            rows.resize(rows.Size + delta);
+        if (new_rows.Size > 0)
+            memcpy(rows.Data + row_n + 1, new_rows.Data, (size_t)new_rows.Size * sizeof(ImGuiTreeClipperRow));
+
+        // Keep track of nav row and of multi-select rows
+        if (tree->_NavRow > row_n)
+            tree->_NavRow = (tree->_NavRow < end_n) ? -1 : tree->_NavRow + delta;
+        if (ms != NULL)
+        {
+            ImGuiTreeClipper_RemapSelectionUserData(&ms->Storage->RangeSrcItem, row_n, end_n, delta, row_n);
+            ImGuiTreeClipper_RemapSelectionUserData(&ms->IO.RangeSrcItem, row_n, end_n, delta, row_n);
+            ImGuiTreeClipper_RemapSelectionUserData(&ms->Storage->NavIdItem, row_n, end_n, delta, ImGuiSelectionUserData_Invalid);
+            ImGuiTreeClipper_RemapSelectionUserData(&ms->IO.NavIdItem, row_n, end_n, delta, ImGuiSelectionUserData_Invalid);
+        }
+    }
+    toggled.resize(0);
+}
+
+void ImGuiTreeClipper::Begin()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    IM_ASSERT(AdapterGetChildCount != NULL && AdapterGetChild != NULL);
+    ImGuiMultiSelectTempData* ms = (g.CurrentMultiSelect != NULL && g.CurrentMultiSelect->Storage->Window == window) ? g.CurrentMultiSelect : NULL;
+
+    if (_NeedRebuild)
+    {
+        Rows.resize(0);
+        ImGuiTreeClipper_AddVisibleRows(this, NULL, AdapterGetChildCount(this, NULL), 0, &Rows);
+        _ToggledRows.resize(0);
+        _NeedRebuild = false;
+        _NavRow = -1;
+    }
+    else if (_ToggledRows.Size > 0)
+    {
+        ImGuiTreeClipper_ApplyToggledRows(this, ms);
+    }
+    if (ms != NULL)
+        ms->IO.ItemsCount = Rows.Size; // Requests returned by EndMultiSelect() apply to updated rows
+
+    Clipper.Ctx = &g; // Helper instance may persist across contexts
+    Clipper.Begin(Rows.Size);
+
+    // Keep parent row of NavId submitted during a NavLeft request, to honor ImGuiTreeNodeFlags_NavLeftJumpsBackHere.
+    // This emulates what TreeNode()/TreePop() do with ImGuiTreeNodeStackData.
+    _NavParentRow = -1;
+    _NavParentID = 0;
+    if (_NavRow >= Rows.Size || (_NavRow != -1 && window->GetID(Rows[_NavRow].Node) != g.NavId))
+        _NavRow = -1;
+    if (_NavRow > 0 && Rows[_NavRow].Depth > 0 && g.NavMoveDir == ImGuiDir_Left && g.NavWindow == window && ImGui::NavMoveRequestButNoResultYet())
+    {
+        int parent_n = _NavRow - 1;
+        while (Rows[parent_n].Depth >= Rows[_NavRow].Depth)
+            parent_n--;
+        _NavParentRow = parent_n;
+        Clipper.IncludeItemByIndex(_NavParentRow);
+        Clipper.IncludeItemByIndex(_NavRow);
+    }
+}
+
+// Called once we are past the last row submitted in the subtree of _NavParentRow (~TreePop())
+static void ImGuiTreeClipper_NavResolveWithParentRow(ImGuiTreeClipper* tree)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.NavIdIsAlive && g.NavMoveDir == ImGuiDir_Left && g.NavWindow == g.CurrentWindow && ImGui::NavMoveRequestButNoResultYet())
+    {
+        ImGuiTreeNodeStackData data;
+        data.ID = tree->_NavParentID;
+        data.TreeFlags = ImGuiTreeNodeFlags_NavLeftJumpsBackHere;
+        data.ItemFlags = tree->_NavParentItemFlags;
+        data.NavRect = ImRect(tree->_NavParentRectMin, tree->_NavParentRectMax);
+        ImGui::NavMoveRequestResolveWithPastTreeNode(&g.NavMoveResultLocal, &data);
+    }
+    tree->_NavParentID = 0;
+}
+
+bool ImGuiTreeClipper::Step()
+{
+    const bool ret = Clipper.Step();
+    DisplayStart = Clipper.DisplayStart;
+    DisplayEnd = Clipper.DisplayEnd;
+    if (!ret && _NavParentID != 0)
+        ImGuiTreeClipper_NavResolveWithParentRow(this);
+    return ret;
+}
+
+bool ImGuiTreeClipper::TreeNode(int row_n, const char* label, ImGuiTreeNodeFlags flags)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(row_n >= 0 && row_n < Rows.Size);
+    IM_ASSERT((flags & ImGuiTreeNodeFlags_NoTreePushOnOpen) == 0 && "TreeNode() always uses ImGuiTreeNodeFlags_NoTreePushOnOpen.");
+    ImGuiTreeClipperRow* row = &Rows[row_n];
+    if (_NavParentID != 0 && row_n > _NavParentRow && row->Depth <= Rows[_NavParentRow].Depth)
+        ImGuiTreeClipper_NavResolveWithParentRow(this);
+
+    const float indent_w = row->Depth * g.Style.IndentSpacing;
+    if (indent_w > 0.0f)
+        ImGui::Indent(indent_w);
+    if (AdapterGetFlags != NULL)
+        flags |= AdapterGetFlags(this, row->Node);
+    flags |= ImGuiTreeNodeFlags_NoTreePushOnOpen;
+    if (row->ChildCount == 0)
+        flags |= ImGuiTreeNodeFlags_Leaf;
+    bool is_open = ImGui::TreeNodeEx(row->Node, flags, "%s", label);
+    if (indent_w > 0.0f)
+        ImGui::Unindent(indent_w);
+
+    if (row->ChildCount > 0 && is_open != row->IsOpen)
+    {
+        row->IsOpen = is_open;
+        _ToggledRows.push_back(row_n);
+    }
+
+    if (g.LastItemData.ID == g.NavId)
+        _NavRow = row_n;
+    if (row_n == _NavParentRow && is_open && (flags & ImGuiTreeNodeFlags_NavLeftJumpsBackHere) && !g.NavIdIsAlive)
+    {
+        _NavParentID = g.LastItemData.ID;
+        _NavParentItemFlags = g.LastItemData.ItemFlags;
+        _NavParentRectMin = g.LastItemData.NavRect.Min;
+        _NavParentRectMax = g.LastItemData.NavRect.Max;
+    }
+    return is_open;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Selectable
 //-------------------------------------------------------------------------
@@ -8004,6 +8799,7 @@ void ImGui::DebugNodeMultiSelectState(ImGuiMultiSelectState* storage)
 //-------------------------------------------------------------------------
 // - ImGuiSelectionBasicStorage
 // - ImGuiSelectionExternalStorage
+// - ImGuiSelectionRangeStorage
 //-------------------------------------------------------------------------
 
 ImGuiSelectionBasicStorage::ImGuiSelectionBasicStorage()
@@ -8020,6 +8816,10 @@ void ImGuiSelectionBasicStorage::Clear()
     Size = 0;
     _SelectionOrder = 1; // Always >0
     _Storage.Data.resize(0);
+#ifdef IMGUI_USE_HASHED_STORAGE
+    _Storage._Index.resize(0);
+    _Storage._IndexedCount = 0;
+#endif
 }
 
 void ImGuiSelectionBasicStorage::Swap(ImGuiSelectionBasicStorage& r)
@@ -8027,6 +8827,10 @@ void ImGuiSelectionBasicStorage::Swap(ImGuiSelectionBasicStorage& r)
     ImSwap(Size, r.Size);
     ImSwap(_SelectionOrder, r._SelectionOrder);
     _Storage.Data.swap(r._Storage.Data);
+#ifdef IMGUI_USE_HASHED_STORAGE
+    _Storage._Index.swap(r._Storage._Index);
+    ImSwap(_Storage._IndexedCount, r._Storage._IndexedCount);
+#endif
 }
 
 bool ImGuiSelectionBasicStorage::Contains(ImGuiID id) const
@@ -8034,11 +8838,11 @@ bool ImGuiSelectionBasicStorage::Contains(ImGuiID id) const
     return _Storage.GetInt(id, 0) != 0;
 }
 
-static int IMGUI_CDECL PairComparerByValueInt(const void* lhs, const void* rhs)
+// Selection order values are >= 0 (0 for unselected items), so they can be radix sorted as unsigned.
+static ImU32 PairGetValueInt(const ImGuiStoragePair& pair)
 {
-    int lhs_v = ((const ImGuiStoragePair*)lhs)->val_i;
-    int rhs_v = ((const ImGuiStoragePair*)rhs)->val_i;
-    return (lhs_v > rhs_v ? +1 : lhs_v < rhs_v ? -1 : 0);
+    IM_ASSERT(pair.val_i >= 0);
+    return (ImU32)pair.val_i;
 }
 
 // GetNextSelectedItem() is an abstraction allowing us to change our underlying actual storage system without impacting user.
@@ -8048,7 +8852,14 @@ bool ImGuiSelectionBasicStorage::GetNextSelectedItem(void** opaque_it, ImGuiID*
     ImGuiStoragePair* it = (ImGuiStoragePair*)*opaque_it;
     ImGuiStoragePair* it_end = _Storage.Data.Data + _Storage.Data.Size;
     if (PreserveOrder && it == NULL && it_end != NULL)
-        ImQsort(_Storage.Data.Data, (size_t)_Storage.Data.Size, sizeof(ImGuiStoragePair), PairComparerByValueInt); // ~ImGuiStorage::BuildSortByValueInt()
+    {
+        ImVector<ImGuiStoragePair> temp; // ~ImGuiStorage::BuildSortByValueInt()
+        temp.resize(_Storage.Data.Size);
+        ImSortRadix<ImGuiStoragePair, PairGetValueInt>(_Storage.Data.Data, _Storage.Data.Size, temp.Data);
+#ifdef IMGUI_USE_HASHED_STORAGE
+        _Storage.BuildSortByKey(); // Only rebuilds index, Data stays sorted by selection order
+#endif
+    }
     if (it == NULL)
         it = _Storage.Data.Data;
     IM_ASSERT(it >= _Storage.Data.Data && it <= it_end);
@@ -8058,8 +8869,10 @@ bool ImGuiSelectionBasicStorage::GetNextSelectedItem(void** opaque_it, ImGuiID*
     const bool has_more = (it != it_end);
     *opaque_it = has_more ? (void**)(it + 1) : (void**)(it);
     *out_id = has_more ? it->key : 0;
+#ifndef IMGUI_USE_HASHED_STORAGE
     if (PreserveOrder && !has_more)
         _Storage.BuildSortByKey();
+#endif
     return has_more;
 }
 
@@ -8074,6 +8887,14 @@ void ImGuiSelectionBasicStorage::SetItemSelected(ImGuiID id, bool selected)
 static void ImGuiSelectionBasicStorage_BatchSetItemSelected(ImGuiSelectionBasicStorage* selection, ImGuiID id, bool selected, int size_before_amends, int selection_order)
 {
     ImGuiStorage* storage = &selection->_Storage;
+#ifdef IMGUI_USE_HASHED_STORAGE
+    // Hashed storage is not sorted, but lookups and insertions are O(1): no need for the append+sort trick.
+    IM_UNUSED(size_before_amends);
+    const bool is_selected = storage->GetInt(id, 0) != 0;
+    if (selected == is_selected)
+        return;
+    storage->SetInt(id, selected ? selection_order : 0);
+#else
     ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + size_before_amends, id);
     const bool is_contained = (it != storage->Data.Data + size_before_amends) && (it->key == id);
     if (selected == (is_contained && it->val_i != 0))
@@ -8082,14 +8903,22 @@ static void ImGuiSelectionBasicStorage_BatchSetItemSelected(ImGuiSelectionBasicS
         storage->Data.push_back(ImGuiStoragePair(id, selection_order)); // Push unsorted at end of vector, will be sorted in SelectionMultiAmendsFinish()
     else if (is_contained)
         it->val_i = selected ? selection_order : 0; // Modify in-place.
+#endif
     selection->Size += selected ? +1 : -1;
 }
 
 static void ImGuiSelectionBasicStorage_BatchFinish(ImGuiSelectionBasicStorage* selection, bool selected, int size_before_amends)
 {
+#ifdef IMGUI_USE_HASHED_STORAGE
+    // Hashed storage was kept indexed by SetInt(): nothing to sort.
+    IM_UNUSED(selection);
+    IM_UNUSED(selected);
+    IM_UNUSED(size_before_amends);
+#else
     ImGuiStorage* storage = &selection->_Storage;
     if (selected && selection->Size != size_before_amends)
         storage->BuildSortByKey(); // When done selecting: sort everything
+#endif
 }
 
 // Apply requests coming from BeginMultiSelect() and EndMultiSelect().
@@ -8122,6 +8951,7 @@ void ImGuiSelectionBasicStorage::ApplyRequests(ImGuiMultiSelectIO* ms_io)
     // - A more optimal version wouldn't even use ImGuiStorage but directly a ImVector<ImGuiID> to reduce bandwidth, but this is a reasonable trade off to reuse code.
     // - There are many ways this could be better optimized. The worse case scenario being: using BoxSelect2d in a grid, box-select scrolling down while wiggling
     //   left and right: it affects coarse clipping + can emit multiple SetRange with 1 item each.)
+    // - If your ImGuiSelectionUserData are indices, ImGuiSelectionRangeStorage stores ranges instead of items and doesn't need to iterate them.
     // FIXME-OPT: For each block of consecutive SetRange request:
     // - add all requests to a sorted list, store ID, selected, offset in ImGuiStorage.
     // - rewrite sorted storage a single time.
@@ -8191,6 +9021,119 @@ void ImGuiSelectionExternalStorage::ApplyRequests(ImGuiMultiSelectIO* ms_io)
     }
 }
 
+//-------------------------------------------------------------------------
+
+ImGuiSelectionRangeStorage::ImGuiSelectionRangeStorage()
+{
+    Size = 0;
+}
+
+void ImGuiSelectionRangeStorage::Clear()
+{
+    Size = 0;
+    _Bounds.resize(0);
+}
+
+void ImGuiSelectionRangeStorage::Swap(ImGuiSelectionRangeStorage& r)
+{
+    ImSwap(Size, r.Size);
+    _Bounds.swap(r._Bounds);
+}
+
+// Return number of boundaries < value (when 'inclusive' is false) or <= value (when 'inclusive' is true)
+static int ImGuiSelectionRangeStorage_CountBounds(const ImVector<int>& bounds, int value, bool inclusive)
+{
+    int lo = 0, hi = bounds.Size;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        if (bounds.Data[mid] < value || (inclusive && bounds.Data[mid] == value))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+bool ImGuiSelectionRangeStorage::Contains(int idx) const
+{
+    return (ImGuiSelectionRangeStorage_CountBounds(_Bounds, idx, true) & 1) != 0;
+}
+
+// Boundaries inside [first, last + 1] are replaced by at most two new boundaries, so the cost is a binary search + moving the tail of the array.
+void ImGuiSelectionRangeStorage::SetRangeSelected(int first, int last, bool selected)
+{
+    IM_ASSERT(first <= last && last < INT_MAX);
+    const int end = last + 1;
+    const int i = ImGuiSelectionRangeStorage_CountBounds(_Bounds, first, false);   // State before 'first' is (i & 1)
+    const int j = ImGuiSelectionRangeStorage_CountBounds(_Bounds, end, true);      // State at 'end' is (j & 1)
+
+    // Count currently selected items in range to maintain Size
+    int selected_count = 0;
+    int pos = first;
+    bool state = (i & 1) != 0;
+    for (int n = i; n < j; n++, state = !state)
+    {
+        const int bound = ImMin(_Bounds.Data[n], end);
+        if (state)
+            selected_count += bound - pos;
+        pos = bound;
+    }
+    if (state)
+        selected_count += end - pos;
+    Size += selected ? (end - first) - selected_count : -selected_count;
+
+    // Replace boundaries
+    int new_bounds[2];
+    int new_count = 0;
+    if (((i & 1) != 0) != selected)
+        new_bounds[new_count++] = first;
+    if (((j & 1) != 0) != selected)
+        new_bounds[new_count++] = end;
+    const int old_count = j - i;
+    for (int n = old_count; n < new_count; n++)
+        _Bounds.insert(_Bounds.Data + i, 0);
+    if (new_count < old_count)
+        _Bounds.erase(_Bounds.Data + i, _Bounds.Data + i + (old_count - new_count));
+    for (int n = 0; n < new_count; n++)
+        _Bounds.Data[i + n] = new_bounds[n];
+}
+
+bool ImGuiSelectionRangeStorage::GetNextSelectedRange(void** opaque_it, int* out_first, int* out_last)
+{
+    const int n = (int)(intptr_t)*opaque_it;
+    IM_ASSERT(n >= 0 && (n & 1) == 0 && n <= _Bounds.Size);
+    if (n >= _Bounds.Size)
+        return false;
+    *out_first = _Bounds.Data[n];
+    *out_last = _Bounds.Data[n + 1] - 1;
+    *opaque_it = (void*)(intptr_t)(n + 2);
+    return true;
+}
+
+// Apply requests coming from BeginMultiSelect() and EndMultiSelect().
+// Unlike ImGuiSelectionBasicStorage, a SetRange request doesn't iterate items: selecting a large range is as cheap as selecting a single item.
+void ImGuiSelectionRangeStorage::ApplyRequests(ImGuiMultiSelectIO* ms_io)
+{
+    for (ImGuiSelectionRequest& req : ms_io->Requests)
+    {
+        if (req.Type == ImGuiSelectionRequestType_SetAll)
+        {
+            Clear();
+            if (req.Selected)
+            {
+                IM_ASSERT(ms_io->ItemsCount != -1 && "Missing value for items_count in BeginMultiSelect() call!");
+                if (ms_io->ItemsCount > 0)
+                    SetRangeSelected(0, ms_io->ItemsCount - 1, true);
+            }
+        }
+        else if (req.Type == ImGuiSelectionRequestType_SetRange)
+        {
+            SetRangeSelected((int)req.RangeFirstItem, (int)req.RangeLastItem, req.Selected);
+        }
+    }
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: ListBox
 //-------------------------------------------------------------------------
@@ -8327,6 +9270,85 @@ bool ImGui::ListBox(const char* label, int* current_item, const char* (*getter)(
 // - others https://github.com/ocornut/imgui/wiki/Useful-Extensions
 //-------------------------------------------------------------------------
 
+struct ImGuiPlotArrayGetterData
+{
+    const float* Values;
+    int Stride;
+
+    ImGuiPlotArrayGetterData(const float* values, int stride) { Values = values; Stride = stride; }
+};
+
+static float Plot_ArrayGetter(void* data, int idx)
+{
+    ImGuiPlotArrayGetterData* plot_data = (ImGuiPlotArrayGetterData*)data;
+    const float v = *(const float*)(const void*)((const unsigned char*)plot_data->Values + (size_t)idx * plot_data->Stride);
+    return v;
+}
+
+// Min/max of values in [idx_min, idx_max) in plot order (before applying values_offset), ignoring NaN.
+// Values submitted through PlotLines()/PlotHistogram() with a float array are read directly instead of calling the getter.
+static void Plot_GetValuesMinMax(float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, int idx_min, int idx_max, float* out_min, float* out_max)
+{
+    float v_min = FLT_MAX;
+    float v_max = -FLT_MAX;
+    if (values_getter != &Plot_ArrayGetter)
+    {
+        for (int i = idx_min, idx = (idx_min + values_offset) % values_count; i < idx_max; i++, idx = (idx + 1 < values_count) ? idx + 1 : 0)
+        {
+            const float v = values_getter(data, idx);
+            if (v != v) // Ignore NaN values
+                continue;
+            v_min = ImMin(v_min, v);
+            v_max = ImMax(v_max, v);
+        }
+        *out_min = v_min;
+        *out_max = v_max;
+        return;
+    }
+
+    // Walk at most two contiguous spans when wrapping around values_offset
+    const ImGuiPlotArrayGetterData* plot_data = (const ImGuiPlotArrayGetterData*)data;
+    int span_begin = (idx_min + values_offset) % values_count;
+    int remaining = idx_max - idx_min;
+    while (remaining > 0)
+    {
+        const int span_count = ImMin(remaining, values_count - span_begin);
+        const unsigned char* p = (const unsigned char*)plot_data->Values + (size_t)span_begin * plot_data->Stride;
+        int i = 0;
+#ifdef IMGUI_ENABLE_SSE
+        if (plot_data->Stride == sizeof(float) && span_count >= 8)
+        {
+            // _mm_min_ps()/_mm_max_ps() return their second operand when either is NaN, so NaN never reach the accumulators
+            __m128 acc_min = _mm_set1_ps(v_min);
+            __m128 acc_max = _mm_set1_ps(v_max);
+            for (; i + 4 <= span_count; i += 4)
+            {
+                const __m128 v = _mm_loadu_ps((const float*)(const void*)p + i);
+                acc_min = _mm_min_ps(v, acc_min);
+                acc_max = _mm_max_ps(v, acc_max);
+            }
+            float mins[4], maxs[4];
+            _mm_storeu_ps(mins, acc_min);
+            _mm_storeu_ps(maxs, acc_max);
+            v_min = ImMin(ImMin(mins[0], mins[1]), ImMin(mins[2], mins[3]));
+            v_max = ImMax(ImMax(maxs[0], maxs[1]), ImMax(maxs[2], maxs[3]));
+        }
+#endif
+        for (; i < span_count; i++)
+        {
+            const float v = *(const float*)(const void*)(p + (size_t)i * plot_data->Stride);
+            if (v != v) // Ignore NaN values
+                continue;
+            v_min = ImMin(v_min, v);
+            v_max = ImMax(v_max, v);
+        }
+        remaining -= span_count;
+        span_begin = 0;
+    }
+    *out_min = v_min;
+    *out_max = v_max;
+}
+
 int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, const ImVec2& size_arg)
 {
     ImGuiContext& g = *GImGui;
@@ -8349,18 +9371,43 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
     bool hovered;
     ButtonBehavior(frame_bb, id, &hovered, NULL);
 
+    const int values_count_min = (plot_type == ImGuiPlotType_Lines) ? 2 : 1;
+    const int res_w = ImMin((int)frame_size.x, values_count) + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
+    const int item_count = values_count + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
+
+    // More values than pixels: each column covers a range of values and we gather their min/max so peaks are not lost.
+    // Columns cover all values so this also gives us the scale, and we only read each value once.
+    float* columns_min = NULL;
+    float* columns_max = NULL;
+    const bool columns_decimate = (values_count >= values_count_min && item_count > res_w && res_w > 0);
+    if (columns_decimate)
+    {
+        columns_min = (float*)MemAllocFrame(sizeof(float) * res_w * 2, sizeof(float));
+        columns_max = columns_min + res_w;
+        for (int n = 0; n < res_w; n++)
+        {
+            const int idx_min = (int)((double)n * item_count / res_w);
+            const int idx_max = (int)((double)(n + 1) * item_count / res_w) + ((plot_type == ImGuiPlotType_Lines) ? 1 : 0); // Lines: include value at next column boundary
+            Plot_GetValuesMinMax(values_getter, data, values_count, values_offset, idx_min, idx_max, &columns_min[n], &columns_max[n]);
+        }
+    }
+
     // Determine scale from values if not specified
     if (scale_min == FLT_MAX || scale_max == FLT_MAX)
     {
         float v_min = FLT_MAX;
         float v_max = -FLT_MAX;
-        for (int i = 0; i < values_count; i++)
+        if (columns_decimate)
         {
-            const float v = values_getter(data, i);
-            if (v != v) // Ignore NaN values
-                continue;
-            v_min = ImMin(v_min, v);
-            v_max = ImMax(v_max, v);
+            for (int n = 0; n < res_w; n++)
+            {
+                v_min = ImMin(v_min, columns_min[n]);
+                v_max = ImMax(v_max, columns_max[n]);
+            }
+        }
+        else
+        {
+            Plot_GetValuesMinMax(values_getter, data, values_count, 0, 0, values_count, &v_min, &v_max);
         }
         if (scale_min == FLT_MAX)
             scale_min = v_min;
@@ -8370,13 +9417,9 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
 
     RenderFrame(frame_bb.Min, frame_bb.Max, GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
 
-    const int values_count_min = (plot_type == ImGuiPlotType_Lines) ? 2 : 1;
     int idx_hovered = -1;
     if (values_count >= values_count_min)
     {
-        int res_w = ImMin((int)frame_size.x, values_count) + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
-        int item_count = values_count + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
-
         // Tooltip on hover
         if (hovered && inner_bb.Contains(g.IO.MousePos))
         {
@@ -8404,30 +9447,78 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
         const ImU32 col_base = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLines : ImGuiCol_PlotHistogram);
         const ImU32 col_hovered = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotHistogramHovered);
 
-        for (int n = 0; n < res_w; n++)
+        if (columns_decimate)
         {
-            const float t1 = t0 + t_step;
-            const int v1_idx = (int)(t0 * item_count + 0.5f);
-            IM_ASSERT(v1_idx >= 0 && v1_idx < values_count);
-            const float v1 = values_getter(data, (v1_idx + values_offset + 1) % values_count);
-            const ImVec2 tp1 = ImVec2( t1, 1.0f - ImSaturate((v1 - scale_min) * inv_scale) );
-
-            // NB: Draw calls are merged together by the DrawList system. Still, we should render our batch are lower level to save a bit of CPU.
-            ImVec2 pos0 = ImLerp(inner_bb.Min, inner_bb.Max, tp0);
-            ImVec2 pos1 = ImLerp(inner_bb.Min, inner_bb.Max, (plot_type == ImGuiPlotType_Lines) ? tp1 : ImVec2(tp1.x, histogram_zero_line_t));
-            if (plot_type == ImGuiPlotType_Lines)
+            // - Lines: connect values at column boundaries + vertical line covering min/max when they exceed those.
+            // - Histogram: bar from the zero line to both the min and max of the column.
+            for (int n = 0; n < res_w; n++)
             {
-                window->DrawList->AddLine(pos0, pos1, idx_hovered == v1_idx ? col_hovered : col_base);
+                const int idx_min = (int)((double)n * item_count / res_w);
+                const int idx_max = (int)((double)(n + 1) * item_count / res_w);
+                const bool is_hovered = (idx_hovered >= idx_min && idx_hovered < idx_max);
+                const float x0 = ImLerp(inner_bb.Min.x, inner_bb.Max.x, (float)n * t_step);
+                const float x1 = ImLerp(inner_bb.Min.x, inner_bb.Max.x, (float)(n + 1) * t_step);
+                const float v_min = columns_min[n];
+                const float v_max = columns_max[n];
+                if (plot_type == ImGuiPlotType_Lines)
+                {
+                    const float v1 = values_getter(data, (idx_max + values_offset) % values_count);
+                    const ImVec2 tp1 = ImVec2((float)(n + 1) * t_step, 1.0f - ImSaturate((v1 - scale_min) * inv_scale));
+                    const ImVec2 pos0 = ImLerp(inner_bb.Min, inner_bb.Max, tp0);
+                    const ImVec2 pos1 = ImLerp(inner_bb.Min, inner_bb.Max, tp1);
+                    const ImU32 col = is_hovered ? col_hovered : col_base;
+                    window->DrawList->AddLine(pos0, pos1, col);
+                    if (v_min <= v_max && (v_min < ImMin(v0, v1) || v_max > ImMax(v0, v1)))
+                    {
+                        const float x_mid = ImTrunc((x0 + x1) * 0.5f);
+                        const float y_top = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_max - scale_min) * inv_scale));
+                        const float y_bottom = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_min - scale_min) * inv_scale));
+                        window->DrawList->AddLine(ImVec2(x_mid, y_top), ImVec2(x_mid, y_bottom), col);
+                    }
+                    v0 = v1;
+                    tp0 = tp1;
+                }
+                else if (plot_type == ImGuiPlotType_Histogram)
+                {
+                    if (v_min > v_max)
+                        continue; // All NaN
+                    const float t_top = ImMin(1.0f - ImSaturate((v_max - scale_min) * inv_scale), histogram_zero_line_t);
+                    const float t_bottom = ImMax(1.0f - ImSaturate((v_min - scale_min) * inv_scale), histogram_zero_line_t);
+                    ImVec2 pos0 = ImVec2(x0, ImLerp(inner_bb.Min.y, inner_bb.Max.y, t_top));
+                    ImVec2 pos1 = ImVec2(x1, ImLerp(inner_bb.Min.y, inner_bb.Max.y, t_bottom));
+                    if (pos1.x >= pos0.x + 2.0f)
+                        pos1.x -= 1.0f;
+                    window->DrawList->AddRectFilled(pos0, pos1, is_hovered ? col_hovered : col_base);
+                }
             }
-            else if (plot_type == ImGuiPlotType_Histogram)
+        }
+        else
+        {
+            for (int n = 0; n < res_w; n++)
             {
-                if (pos1.x >= pos0.x + 2.0f)
-                    pos1.x -= 1.0f;
-                window->DrawList->AddRectFilled(pos0, pos1, idx_hovered == v1_idx ? col_hovered : col_base);
-            }
+                const float t1 = t0 + t_step;
+                const int v1_idx = (int)(t0 * item_count + 0.5f);
+                IM_ASSERT(v1_idx >= 0 && v1_idx < values_count);
+                const float v1 = values_getter(data, (v1_idx + values_offset + 1) % values_count);
+                const ImVec2 tp1 = ImVec2( t1, 1.0f - ImSaturate((v1 - scale_min) * inv_scale) );
+
+                // NB: Draw calls are merged together by the DrawList system. Still, we should render our batch are lower level to save a bit of CPU.
+                ImVec2 pos0 = ImLerp(inner_bb.Min, inner_bb.Max, tp0);
+                ImVec2 pos1 = ImLerp(inner_bb.Min, inner_bb.Max, (plot_type == ImGuiPlotType_Lines) ? tp1 : ImVec2(tp1.x, histogram_zero_line_t));
+                if (plot_type == ImGuiPlotType_Lines)
+                {
+                    window->DrawList->AddLine(pos0, pos1, idx_hovered == v1_idx ? col_hovered : col_base);
+                }
+                else if (plot_type == ImGuiPlotType_Histogram)
+                {
+                    if (pos1.x >= pos0.x + 2.0f)
+                        pos1.x -= 1.0f;
+                    window->DrawList->AddRectFilled(pos0, pos1, idx_hovered == v1_idx ? col_hovered : col_base);
+                }
 
-            t0 = t1;
-            tp0 = tp1;
+                t0 = t1;
+                tp0 = tp1;
+            }
         }
     }
 
@@ -8443,21 +9534,6 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
     return idx_hovered;
 }
 
-struct ImGuiPlotArrayGetterData
-{
-    const float* Values;
-    int Stride;
-
-    ImGuiPlotArrayGetterData(const float* values, int stride) { Values = values; Stride = stride; }
-};
-
-static float Plot_ArrayGetter(void* data, int idx)
-{
-    ImGuiPlotArrayGetterData* plot_data = (ImGuiPlotArrayGetterData*)data;
-    const float v = *(const float*)(const void*)((const unsigned char*)plot_data->Values + (size_t)idx * plot_data->Stride);
-    return v;
-}
-
 void ImGui::PlotLines(const char* label, const float* values, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride)
 {
     ImGuiPlotArrayGetterData data(values, stride);
@@ -9143,22 +10219,18 @@ static inline int TabItemGetSectionIdx(const ImGuiTabItem* tab)
     return (tab->Flags & ImGuiTabItemFlags_Leading) ? 0 : (tab->Flags & ImGuiTabItemFlags_Trailing) ? 2 : 1;
 }
 
-static int IMGUI_CDECL TabItemComparerBySection(const void* lhs, const void* rhs)
+static int TabItemComparerBySection(const ImGuiTabItem& a, const ImGuiTabItem& b)
 {
-    const ImGuiTabItem* a = (const ImGuiTabItem*)lhs;
-    const ImGuiTabItem* b = (const ImGuiTabItem*)rhs;
-    const int a_section = TabItemGetSectionIdx(a);
-    const int b_section = TabItemGetSectionIdx(b);
+    const int a_section = TabItemGetSectionIdx(&a);
+    const int b_section = TabItemGetSectionIdx(&b);
     if (a_section != b_section)
         return a_section - b_section;
-    return (int)(a->IndexDuringLayout - b->IndexDuringLayout);
+    return (int)(a.IndexDuringLayout - b.IndexDuringLayout);
 }
 
-static int IMGUI_CDECL TabItemComparerByBeginOrder(const void* lhs, const void* rhs)
+static int TabItemComparerByBeginOrder(const ImGuiTabItem& a, const ImGuiTabItem& b)
 {
-    const ImGuiTabItem* a = (const ImGuiTabItem*)lhs;
-    const ImGuiTabItem* b = (const ImGuiTabItem*)rhs;
-    return (int)(a->BeginOrder - b->BeginOrder);
+    return (int)(a.BeginOrder - b.BeginOrder);
 }
 
 static ImGuiTabBar* GetTabBarFromTabBarRef(const ImGuiPtrOrIndex& ref)
@@ -9221,7 +10293,7 @@ bool    ImGui::BeginTabBarEx(ImGuiTabBar* tab_bar, const ImRect& tab_bar_bb, ImG
     // Ensure correct ordering when toggling ImGuiTabBarFlags_Reorderable flag, or when a new tab was added while being not reorderable
     if ((flags & ImGuiTabBarFlags_Reorderable) != (tab_bar->Flags & ImGuiTabBarFlags_Reorderable) || (tab_bar->TabsAddedNew && !(flags & ImGuiTabBarFlags_Reorderable)))
         if ((flags & ImGuiTabBarFlags_DockNode) == 0) // FIXME: TabBar with DockNode can now be hybrid
-            ImQsort(tab_bar->Tabs.Data, tab_bar->Tabs.Size, sizeof(ImGuiTabItem), TabItemComparerByBeginOrder);
+            ImSort<ImGuiTabItem, TabItemComparerByBeginOrder>(tab_bar->Tabs.Data, tab_bar->Tabs.Size);
     tab_bar->TabsAddedNew = false;
 
     // Flags
@@ -9349,7 +10421,7 @@ static void ImGui::TabBarLayout(ImGuiTabBar* tab_bar)
         tab_bar->Tabs.resize(tab_dst_n);
 
     if (need_sort_by_section)
-        ImQsort(tab_bar->Tabs.Data, tab_bar->Tabs.Size, sizeof(ImGuiTabItem), TabItemComparerBySection);
+        ImSort<ImGuiTabItem, TabItemComparerBySection>(tab_bar->Tabs.Data, tab_bar->Tabs.Size);
 
     // Calculate spacing between sections
     sections[0].Spacing = sections[0].TabCount > 0 && (sections[1].TabCount + sections[2].TabCount) > 0 ? g.Style.ItemInnerSpacing.x : 0.0f;
@@ -5,6 +5,8 @@
 // - Fix in stb_textedit_find_charpos to handle last line (see https://github.com/ocornut/imgui/issues/6000 + #6783)
 // - Added name to struct or it may be forward declared in our code.
 // - Added UTF-8 support (see https://github.com/nothings/stb/issues/188 + https://github.com/ocornut/imgui/pull/7925)
+// - Added optional STB_TEXTEDIT_SEEKROW_CHAR/STB_TEXTEDIT_SEEKROW_Y to skip rows when locating a character or a coordinate.
+// - Added optional IMSTB_TEXTEDIT_UNDO_EXTERNAL to store undo/redo history outside of STB_TexteditState.
 // Grep for [DEAR IMGUI] to find the changes.
 // - Also renamed macros used or defined outside of IMSTB_TEXTEDIT_IMPLEMENTATION block from STB_TEXTEDIT_* to IMSTB_TEXTEDIT_*
 
@@ -177,6 +179,15 @@
 //    STB_TEXTEDIT_K_LINEEND2            secondary keyboard input to move cursor to end of line
 //    STB_TEXTEDIT_K_TEXTSTART2          secondary keyboard input to move cursor to start of text
 //    STB_TEXTEDIT_K_TEXTEND2            secondary keyboard input to move cursor to end of text
+//    STB_TEXTEDIT_SEEKROW_CHAR(obj,n,&i,&prev,&y)  [DEAR IMGUI] skip rows located before the row containing character #n:
+//                                          may set start (i), start of previous row (prev) and y of a preceding row
+//    STB_TEXTEDIT_SEEKROW_Y(obj,y,&i,&base_y)      [DEAR IMGUI] skip rows located above 'y':
+//                                          may set start (i) and y (base_y) of a row located above 'y'
+//    IMSTB_TEXTEDIT_UNDO_EXTERNAL       [DEAR IMGUI] don't declare StbUndoState, undo/redo history is stored by the user, who needs to define:
+//      STB_TEXTEDIT_MAKEUNDO(obj,i,n,c*,m)  record the replacement of n characters at i by m characters (pointed to by c*).
+//                                          called before the replacement, except when n == 0 where it may be called after insertion.
+//      STB_TEXTEDIT_UNDO(obj)             apply undo, returns position to move cursor to, or -1 if there is nothing to undo
+//      STB_TEXTEDIT_REDO(obj)             apply redo, returns position to move cursor to, or -1 if there is nothing to redo
 //
 // Keyboard input must be encoded as a single integer value; e.g. a character code
 // and some bitflags that represent shift states. to simplify the interface, SHIFT must
@@ -308,6 +319,7 @@
 #define IMSTB_TEXTEDIT_POSITIONTYPE    int
 #endif
 
+#ifndef IMSTB_TEXTEDIT_UNDO_EXTERNAL // [DEAR IMGUI]
 typedef struct
 {
    // private data
@@ -325,6 +337,7 @@ typedef struct
    short undo_point, redo_point;
    int undo_char_point, redo_char_point;
 } StbUndoState;
+#endif
 
 typedef struct STB_TexteditState
 {
@@ -361,7 +374,9 @@ typedef struct STB_TexteditState
    unsigned char single_line;
    unsigned char padding1, padding2, padding3;
    float preferred_x; // this determines where the cursor up/down tries to seek to along x
+#ifndef IMSTB_TEXTEDIT_UNDO_EXTERNAL // [DEAR IMGUI]
    StbUndoState undostate;
+#endif
 } STB_TexteditState;
 
 
@@ -418,6 +433,10 @@ static int stb_text_locate_coord(IMSTB_TEXTEDIT_STRING *str, float x, float y)
    r.ymin = r.ymax = 0;
    r.num_chars = 0;
 
+#ifdef STB_TEXTEDIT_SEEKROW_Y
+   STB_TEXTEDIT_SEEKROW_Y(str, y, &i, &base_y); // [DEAR IMGUI]
+#endif
+
    // search rows to find one that straddles 'y'
    while (i < n) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
@@ -514,8 +533,8 @@ static void stb_textedit_drag(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *sta
 static void stb_text_undo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state);
 static void stb_text_redo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state);
 static void stb_text_makeundo_delete(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int length);
-static void stb_text_makeundo_insert(STB_TexteditState *state, int where, int length);
-static void stb_text_makeundo_replace(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int old_length, int new_length);
+static void stb_text_makeundo_insert(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, const IMSTB_TEXTEDIT_CHARTYPE *text, int length);
+static void stb_text_makeundo_replace(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int old_length, const IMSTB_TEXTEDIT_CHARTYPE *text, int new_length);
 
 typedef struct
 {
@@ -547,6 +566,9 @@ static void stb_textedit_find_charpos(StbFindState *find, IMSTB_TEXTEDIT_STRING
 
    // search rows to find the one that straddles character n
    find->y = 0;
+#ifdef STB_TEXTEDIT_SEEKROW_CHAR
+   STB_TEXTEDIT_SEEKROW_CHAR(str, n, &i, &prev_start, &find->y); // [DEAR IMGUI]
+#endif
 
    for(;;) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
@@ -726,7 +748,7 @@ static int stb_textedit_paste_internal(IMSTB_TEXTEDIT_STRING *str, STB_TexteditS
    stb_textedit_delete_selection(str,state);
    // try to insert the characters
    if (STB_TEXTEDIT_INSERTCHARS(str, state->cursor, text, len)) {
-      stb_text_makeundo_insert(state, state->cursor, len);
+      stb_text_makeundo_insert(str, state, state->cursor, text, len);
       state->cursor += len;
       state->has_preferred_x = 0;
       return 1;
@@ -747,7 +769,7 @@ static void stb_textedit_text(IMSTB_TEXTEDIT_STRING* str, STB_TexteditState* sta
       return;
 
    if (state->insert_mode && !STB_TEXT_HAS_SELECTION(state) && state->cursor < STB_TEXTEDIT_STRINGLEN(str)) {
-      stb_text_makeundo_replace(str, state, state->cursor, 1, 1);
+      stb_text_makeundo_replace(str, state, state->cursor, 1, text, text_len); // [DEAR IMGUI] new_length is text_len (UTF-8)
       STB_TEXTEDIT_DELETECHARS(str, state->cursor, 1);
       if (STB_TEXTEDIT_INSERTCHARS(str, state->cursor, text, text_len)) {
          state->cursor += text_len;
@@ -757,7 +779,7 @@ static void stb_textedit_text(IMSTB_TEXTEDIT_STRING* str, STB_TexteditState* sta
    else {
       stb_textedit_delete_selection(str, state); // implicitly clamps
       if (STB_TEXTEDIT_INSERTCHARS(str, state->cursor, text, text_len)) {
-         stb_text_makeundo_insert(state, state->cursor, text_len);
+         stb_text_makeundo_insert(str, state, state->cursor, text, text_len);
          state->cursor += text_len;
          state->has_preferred_x = 0;
       }
@@ -1139,6 +1161,42 @@ retry:
 //
 // @OPTIMIZE: the undo/redo buffer should be circular
 
+#ifdef IMSTB_TEXTEDIT_UNDO_EXTERNAL // [DEAR IMGUI]
+
+static void stb_text_undo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state)
+{
+   int cursor = STB_TEXTEDIT_UNDO(str);
+   if (cursor >= 0)
+      state->cursor = cursor;
+}
+
+static void stb_text_redo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state)
+{
+   int cursor = STB_TEXTEDIT_REDO(str);
+   if (cursor >= 0)
+      state->cursor = cursor;
+}
+
+static void stb_text_makeundo_insert(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, const IMSTB_TEXTEDIT_CHARTYPE *text, int length)
+{
+   STB_TEXTEDIT_MAKEUNDO(str, where, 0, text, length);
+   (void)state;
+}
+
+static void stb_text_makeundo_delete(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int length)
+{
+   STB_TEXTEDIT_MAKEUNDO(str, where, length, NULL, 0);
+   (void)state;
+}
+
+static void stb_text_makeundo_replace(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int old_length, const IMSTB_TEXTEDIT_CHARTYPE *text, int new_length)
+{
+   STB_TEXTEDIT_MAKEUNDO(str, where, old_length, text, new_length);
+   (void)state;
+}
+
+#else
+
 static void stb_textedit_flush_redo(StbUndoState *state)
 {
    state->redo_point = IMSTB_TEXTEDIT_UNDOSTATECOUNT;
@@ -1361,9 +1419,10 @@ static void stb_text_redo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state)
    s->redo_point++;
 }
 
-static void stb_text_makeundo_insert(STB_TexteditState *state, int where, int length)
+static void stb_text_makeundo_insert(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, const IMSTB_TEXTEDIT_CHARTYPE *text, int length)
 {
    stb_text_createundo(&state->undostate, where, 0, length);
+   (void)str; (void)text;
 }
 
 static void stb_text_makeundo_delete(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int length)
@@ -1376,7 +1435,7 @@ static void stb_text_makeundo_delete(IMSTB_TEXTEDIT_STRING *str, STB_TexteditSta
    }
 }
 
-static void stb_text_makeundo_replace(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int old_length, int new_length)
+static void stb_text_makeundo_replace(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int old_length, const IMSTB_TEXTEDIT_CHARTYPE *text, int new_length)
 {
    int i;
    IMSTB_TEXTEDIT_CHARTYPE *p = stb_text_createundo(&state->undostate, where, old_length, new_length);
@@ -1384,15 +1443,20 @@ static void stb_text_makeundo_replace(IMSTB_TEXTEDIT_STRING *str, STB_TexteditSt
       for (i=0; i < old_length; ++i)
          p[i] = STB_TEXTEDIT_GETCHAR(str, where+i);
    }
+   (void)text;
 }
 
+#endif // IMSTB_TEXTEDIT_UNDO_EXTERNAL
+
 // reset the state to default
 static void stb_textedit_clear_state(STB_TexteditState *state, int is_single_line)
 {
+#ifndef IMSTB_TEXTEDIT_UNDO_EXTERNAL // [DEAR IMGUI]
    state->undostate.undo_point = 0;
    state->undostate.undo_char_point = 0;
    state->undostate.redo_point = IMSTB_TEXTEDIT_UNDOSTATECOUNT;
    state->undostate.redo_char_point = IMSTB_TEXTEDIT_UNDOCHARCOUNT;
+#endif
    state->select_end = state->select_start = 0;
    state->cursor = 0;
    state->has_preferred_x = 0;
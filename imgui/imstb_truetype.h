@@ -1124,6 +1124,12 @@ typedef int stbtt__test_oversample_pow2[(STBTT_MAX_OVERSAMPLE & (STBTT_MAX_OVERS
 #define STBTT_RASTERIZER_VERSION 2
 #endif
 
+// [DEAR IMGUI] SSE2 paths for oversampling box filters. Output is identical to the scalar paths.
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define STBTT__SSE2
+#include <emmintrin.h>
+#endif
+
 #ifdef _MSC_VER
 #define STBTT__NOTUSED(v)  (void)(v)
 #else
@@ -4017,11 +4023,84 @@ STBTT_DEF void stbtt_PackSetSkipMissingCodepoints(stbtt_pack_context *spc, int s
 
 #define STBTT__OVER_MASK  (STBTT_MAX_OVERSAMPLE-1)
 
+#ifdef STBTT__SSE2
+// [DEAR IMGUI] SSE2 box filters.
+// Each output is the sum of the last kernel_width input pixels (zero before the start of the line/column), which is what the scalar running total computes.
+// Division by kernel_width uses a 16-bit fixed point reciprocal: exact for totals up to 255*STBTT_MAX_OVERSAMPLE.
+#define STBTT__PREFILTER_SSE2_MAX_W   1024
+
+// Filter whole bitmap, return 0 if lines are too long for our buffer (caller uses scalar path).
+static int stbtt__h_prefilter_sse2(unsigned char *pixels, int w, int h, int stride_in_bytes, unsigned int kernel_width)
+{
+   unsigned char line[STBTT_MAX_OVERSAMPLE + STBTT__PREFILTER_SSE2_MAX_W + 16];
+   const __m128i recip = _mm_set1_epi16((short) (unsigned short) ((65536 + kernel_width - 1) / kernel_width));
+   const __m128i zero = _mm_setzero_si128();
+   const int k = (int) kernel_width;
+   int j;
+   if (w > STBTT__PREFILTER_SSE2_MAX_W || kernel_width > STBTT_MAX_OVERSAMPLE)
+      return 0;
+   STBTT_memset(line, 0, sizeof(line));
+   for (j=0; j < h; ++j) {
+      // Copy line so we can write in place, with kernel_width zeroes in front
+      int i, t;
+      STBTT_memcpy(line + k, pixels, w);
+      for (i=0; i + 16 <= w; i += 16) {
+         __m128i total_lo = zero, total_hi = zero;
+         for (t=0; t < k; ++t) {
+            __m128i p = _mm_loadu_si128((const __m128i *) (line + k + i - t));
+            total_lo = _mm_add_epi16(total_lo, _mm_unpacklo_epi8(p, zero));
+            total_hi = _mm_add_epi16(total_hi, _mm_unpackhi_epi8(p, zero));
+         }
+         _mm_storeu_si128((__m128i *) (pixels + i), _mm_packus_epi16(_mm_mulhi_epu16(total_lo, recip), _mm_mulhi_epu16(total_hi, recip)));
+      }
+      for (; i < w; ++i) {
+         unsigned int total = 0;
+         for (t=0; t < k; ++t)
+            total += line[k + i - t];
+         pixels[i] = (unsigned char) (total / kernel_width);
+      }
+      pixels += stride_in_bytes;
+   }
+   return 1;
+}
+
+// Filter columns 16 at a time, return number of columns processed (caller uses scalar path for remaining columns).
+static int stbtt__v_prefilter_sse2(unsigned char *pixels, int w, int h, int stride_in_bytes, unsigned int kernel_width)
+{
+   const __m128i recip = _mm_set1_epi16((short) (unsigned short) ((65536 + kernel_width - 1) / kernel_width));
+   const __m128i zero = _mm_setzero_si128();
+   int j;
+   if (kernel_width > STBTT_MAX_OVERSAMPLE)
+      return 0;
+   for (j=0; j + 16 <= w; j += 16) {
+      __m128i buffer[STBTT_MAX_OVERSAMPLE];
+      __m128i total_lo = zero, total_hi = zero;
+      unsigned char *p = pixels + j;
+      int i;
+      for (i=0; i < STBTT_MAX_OVERSAMPLE; ++i)
+         buffer[i] = zero;
+      for (i=0; i < h; ++i, p += stride_in_bytes) {
+         __m128i in = _mm_loadu_si128((const __m128i *) p);
+         __m128i out = buffer[i & STBTT__OVER_MASK];
+         total_lo = _mm_sub_epi16(_mm_add_epi16(total_lo, _mm_unpacklo_epi8(in, zero)), _mm_unpacklo_epi8(out, zero));
+         total_hi = _mm_sub_epi16(_mm_add_epi16(total_hi, _mm_unpackhi_epi8(in, zero)), _mm_unpackhi_epi8(out, zero));
+         buffer[(i+kernel_width) & STBTT__OVER_MASK] = in;
+         _mm_storeu_si128((__m128i *) p, _mm_packus_epi16(_mm_mulhi_epu16(total_lo, recip), _mm_mulhi_epu16(total_hi, recip)));
+      }
+   }
+   return j;
+}
+#endif
+
 static void stbtt__h_prefilter(unsigned char *pixels, int w, int h, int stride_in_bytes, unsigned int kernel_width)
 {
    unsigned char buffer[STBTT_MAX_OVERSAMPLE];
    int safe_w = w - kernel_width;
    int j;
+#ifdef STBTT__SSE2
+   if (stbtt__h_prefilter_sse2(pixels, w, h, stride_in_bytes, kernel_width)) // [DEAR IMGUI]
+      return;
+#endif
    STBTT_memset(buffer, 0, STBTT_MAX_OVERSAMPLE); // suppress bogus warning from VS2013 -analyze
    for (j=0; j < h; ++j) {
       int i;
@@ -4084,6 +4163,13 @@ static void stbtt__v_prefilter(unsigned char *pixels, int w, int h, int stride_i
    unsigned char buffer[STBTT_MAX_OVERSAMPLE];
    int safe_h = h - kernel_width;
    int j;
+#ifdef STBTT__SSE2
+   {
+      int simd_w = stbtt__v_prefilter_sse2(pixels, w, h, stride_in_bytes, kernel_width); // [DEAR IMGUI]
+      pixels += simd_w;
+      w -= simd_w;
+   }
+#endif
    STBTT_memset(buffer, 0, STBTT_MAX_OVERSAMPLE); // suppress bogus warning from VS2013 -analyze
    for (j=0; j < w; ++j) {
       int i;